@@ -0,0 +1,164 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_MPC_CONTROLLER__ACADOS_MPC_CONTROLLER_HPP_
+#define ACADOS_MPC_CONTROLLER__ACADOS_MPC_CONTROLLER_HPP_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "controller_interface/controller_interface.hpp"
+#include "pluginlib/class_loader.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_lifecycle/state.hpp"
+#include "realtime_tools/realtime_buffer.h"
+#include "std_msgs/msg/float64_multi_array.hpp"
+
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_mpc_controller/visibility_control.h"
+
+namespace acados_mpc_controller
+{
+
+class AcadosMpcController : public controller_interface::ControllerInterface
+/**
+* @brief Generic ros2_control MPC controller running an `acados::AcadosSolver` plugin.
+*
+* At configure time, the solver plugin is loaded and initialized, and the state (resp. command) interfaces
+* are mapped by name to the indexes of the solver state (resp. control) vector using `x_index_map()`
+* (resp. `u_index_map()`). The update loop then only performs preresolved copies and a solve:
+*   1. apply the latest runtime parameters (if any) received through a realtime buffer,
+*   2. copy the state interfaces to the initial state,
+*   3. solve the OCP and write the control of stage 0 to the command interfaces.
+*
+* Parameters:
+*   - `solver_plugin` (string): name of the solver plugin (e.g., "acados_solver_plugins_example/MockAcadosSolver");
+*   - `N` (int) and `Ts` (double): horizon length and sampling period passed to `AcadosSolver::init()`;
+*   - `state_keys` (string array): keys of `x_index_map()`, all state variables must be covered;
+*   - `state_interfaces` (string array): full state interface names, one per state variable of `state_keys`
+*     (in the order of the keys, then of the indexes of each key);
+*   - `control_keys` (string array) and `command_interfaces` (string array): same for the controls.
+*
+* The runtime parameters can be sent on the `~/runtime_parameters` topic (`std_msgs/Float64MultiArray` of size np,
+* applied to all stages, or np * (N+1), stage by stage). Derived controllers can also call
+* `set_runtime_parameters_from_non_rt()` and override the `before_solve()` / `after_solve()` hooks.
+*/
+{
+public:
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  AcadosMpcController();
+
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  controller_interface::InterfaceConfiguration command_interface_configuration() const override;
+
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  controller_interface::InterfaceConfiguration state_interface_configuration() const override;
+
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  controller_interface::CallbackReturn on_init() override;
+
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  controller_interface::CallbackReturn on_configure(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  controller_interface::CallbackReturn on_activate(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  controller_interface::CallbackReturn on_deactivate(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  controller_interface::CallbackReturn on_cleanup(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  controller_interface::return_type update(
+    const rclcpp::Time & time, const rclcpp::Duration & period) override;
+
+protected:
+  /**
+   * @brief Queue a runtime parameters trajectory, applied at the beginning of the next update.
+   *
+   * Must NOT be called from the realtime loop (allocation).
+   *
+   * @param p_traj Runtime parameters of size (np, N+1), or (np, 1) for all stages.
+   * @return true if the dimensions are valid.
+   */
+  bool set_runtime_parameters_from_non_rt(acados::ColumnMajorXd const & p_traj);
+
+  /**
+   * @brief Hook called by `update()` after the initial state is set and before the solve.
+   *
+   * @param time Current time.
+   * @return true to proceed with the solve.
+   */
+  virtual bool before_solve(const rclcpp::Time & time);
+
+  /**
+   * @brief Hook called by `update()` after the solve, before the commands are written.
+   *
+   * @param time Current time.
+   * @param status Solver status.
+   * @return true to write the control of stage 0 to the command interfaces.
+   */
+  virtual bool after_solve(const rclcpp::Time & time, int status);
+
+  /// @brief Returns the solver (valid once configured).
+  acados::AcadosSolver & solver();
+
+  /// @brief Initial state written by `update()` (size nx).
+  acados::ValueVector _x0;
+
+  /// @brief Control of stage 0 written to the command interfaces (size nu).
+  acados::ValueVector _u0;
+
+private:
+  /**
+   * @brief Resolve the solver indexes of the interfaces (keys expanded in the order of `index_map`).
+   *
+   * @return false if a key is unknown or if the number of interfaces does not match.
+   */
+  bool map_interfaces(
+    acados::IndexMap const & index_map,
+    std::vector<std::string> const & keys,
+    std::vector<std::string> const & interface_names,
+    std::vector<unsigned int> & indexes) const;
+
+  // Solver plugin (the loader must outlive the solver)
+  std::unique_ptr<pluginlib::ClassLoader<acados::AcadosSolver>> _solver_loader;
+  std::shared_ptr<acados::AcadosSolver> _solver;
+
+  // Parameters
+  std::string _solver_plugin;
+  std::vector<std::string> _state_keys, _state_interface_names;
+  std::vector<std::string> _control_keys, _command_interface_names;
+
+  /// @brief Solver index of each (loaned) state/command interface, in the order of the configuration.
+  std::vector<unsigned int> _state_indexes, _command_indexes;
+
+  // Runtime parameters (non-RT to RT)
+  realtime_tools::RealtimeBuffer<std::shared_ptr<acados::ColumnMajorXd>> _p_buffer;
+  std::shared_ptr<acados::ColumnMajorXd> _last_applied_p;
+  rclcpp::Subscription<std_msgs::msg::Float64MultiArray>::SharedPtr _p_subscriber;
+};
+
+}  // namespace acados_mpc_controller
+
+#endif  // ACADOS_MPC_CONTROLLER__ACADOS_MPC_CONTROLLER_HPP_
@@ -0,0 +1,122 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_MPC_CONTROLLER__ACADOS_SOLVER_NODE_HPP_
+#define ACADOS_MPC_CONTROLLER__ACADOS_SOLVER_NODE_HPP_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pluginlib/class_loader.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_lifecycle/lifecycle_node.hpp"
+#include "rclcpp_lifecycle/lifecycle_publisher.hpp"
+#include "std_msgs/msg/float64_multi_array.hpp"
+#include "std_srvs/srv/trigger.hpp"
+
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_mpc_controller/visibility_control.h"
+
+namespace acados_mpc_controller
+{
+
+class AcadosSolverNode : public rclcpp_lifecycle::LifecycleNode
+/**
+* @brief Lifecycle node serving an `acados::AcadosSolver` plugin to non-realtime clients (MPC-as-a-service).
+*
+* The solve requests are received on `~/solve_request` (`std_msgs/Float64MultiArray`) as the initial state
+* (size nx), optionally followed by the runtime parameters (size np for all stages, or np * (N+1)).
+* Bursts of requests are coalesced: only the latest request is solved, by a dedicated solver thread,
+* and the older pending ones are dropped.
+*
+* The solutions are published on `~/solution` (`std_msgs/Float64MultiArray`) as
+* `[status, time_tot, x_0, ..., x_N, u_0, ..., u_{N-1}]`. The layout describes the state trajectory
+* (`data_offset` = 2, dimensions "stage" of size N+1 and "x" of size nx), and the control trajectory
+* follows it (offset 2 + (N+1) * nx, N * nu values, row-major).
+* The service `~/get_statistics` (`std_srvs/Trigger`) returns the request, coalescing, and throughput statistics.
+*
+* Parameters: `solver_plugin` (string), `N` (int), and `Ts` (double), read at configure time.
+*/
+{
+public:
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  explicit AcadosSolverNode(const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
+
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  ~AcadosSolverNode() override;
+
+  using CallbackReturn = rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn;
+
+  CallbackReturn on_configure(const rclcpp_lifecycle::State & previous_state) override;
+  CallbackReturn on_activate(const rclcpp_lifecycle::State & previous_state) override;
+  CallbackReturn on_deactivate(const rclcpp_lifecycle::State & previous_state) override;
+  CallbackReturn on_cleanup(const rclcpp_lifecycle::State & previous_state) override;
+  CallbackReturn on_shutdown(const rclcpp_lifecycle::State & previous_state) override;
+
+private:
+  /// @brief Store the request in the pending slot (the previous pending request, if any, is dropped).
+  void request_callback(const std_msgs::msg::Float64MultiArray::SharedPtr msg);
+
+  /// @brief Loop of the solver thread: wait for a request, solve it, and publish the solution.
+  void solver_loop();
+
+  /// @brief Stop and join the solver thread.
+  void stop_solver_thread();
+
+  /// @brief Apply the request to the solver (returns false if the request is invalid).
+  bool apply_request(std::vector<double> const & request);
+
+  /// @brief Write the solution of the solver into `_solution_msg`.
+  void fill_solution(int status);
+
+  // Solver plugin (the loader must outlive the solver)
+  std::unique_ptr<pluginlib::ClassLoader<acados::AcadosSolver>> _solver_loader;
+  std::shared_ptr<acados::AcadosSolver> _solver;
+
+  // ROS interfaces
+  rclcpp::Subscription<std_msgs::msg::Float64MultiArray>::SharedPtr _request_subscriber;
+  rclcpp_lifecycle::LifecyclePublisher<std_msgs::msg::Float64MultiArray>::SharedPtr _solution_publisher;
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr _statistics_service;
+  std_msgs::msg::Float64MultiArray _solution_msg;
+
+  // Pending request (latest one only)
+  std::mutex _mutex;
+  std::condition_variable _request_cv;
+  std::vector<double> _pending_request, _current_request;
+  bool _has_pending_request = false;
+  bool _stop_requested = false;
+  std::thread _solver_thread;
+
+  // Statistics (protected by `_mutex`)
+  size_t _num_requests = 0;
+  size_t _num_coalesced = 0;
+  size_t _num_invalid = 0;
+  size_t _num_solves = 0;
+  size_t _num_failures = 0;
+  double _total_solve_time = 0.0;
+  rclcpp::Time _activation_time;
+
+  // Scratch
+  acados::ValueVector _x0, _p;
+};
+
+}  // namespace acados_mpc_controller
+
+#endif  // ACADOS_MPC_CONTROLLER__ACADOS_SOLVER_NODE_HPP_
@@ -0,0 +1,149 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_MPC_CONTROLLER__TRAJECTORY_MSG_BINDING_HPP_
+#define ACADOS_MPC_CONTROLLER__TRAJECTORY_MSG_BINDING_HPP_
+
+#include <Eigen/Dense>
+
+#include <string>
+#include <vector>
+
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_mpc_controller/visibility_control.h"
+
+namespace acados_mpc_controller
+{
+
+class TrajectoryMsgBinding
+/**
+* @brief Preresolved binding between the solution of an `acados::AcadosSolver` and a
+* `trajectory_msgs::msg::JointTrajectory` message.
+*
+* Each field of the trajectory points (positions, velocities, accelerations, effort) can be bound to
+* keys of `x_index_map()` or `u_index_map()`. The keys are resolved once at construction, then `fill()`
+* writes each stage of `ocp_nlp_out` into a message preallocated by `prepare()`, without any allocation
+* nor intermediate `ValueVector` (e.g., to publish the prediction at 100 Hz from a realtime publisher).
+*
+* Typical usage:
+* @code
+* TrajectoryMsgBinding::Options options;
+* options.joint_names = {"cart"};
+* options.positions = {TrajectoryMsgBinding::Variable::STATE, {"p"}};
+* options.velocities = {TrajectoryMsgBinding::Variable::STATE, {"p_dot"}};
+* TrajectoryMsgBinding binding(solver, options);
+* binding.prepare(msg);     // Once (allocation)
+* binding.fill(solver, msg);  // After each solve
+* @endcode
+*/
+{
+public:
+  /// @brief Solver variable a field is bound to.
+  enum class Variable {STATE, CONTROL};
+
+  class FieldBinding
+  {
+public:
+    Variable variable = Variable::STATE;
+    /// @brief Keys of the index map of `variable` (empty to leave the field empty).
+    std::vector<std::string> keys;
+  };
+
+  class Options
+  {
+public:
+    std::vector<std::string> joint_names;
+    FieldBinding positions;
+    FieldBinding velocities;
+    FieldBinding accelerations;
+    FieldBinding effort;
+    /// @brief Maximum number of points (zero for N+1). The control at stage N is the one of stage N-1.
+    size_t capacity = 0;
+  };
+
+  /**
+   * @brief Constructor of the TrajectoryMsgBinding object.
+   *
+   * @throws std::invalid_argument if a key is unknown or if the number of bound variables of a field
+   * does not match the number of joints.
+   *
+   * @param solver Initialized solver.
+   * @param options Binding options.
+   */
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  TrajectoryMsgBinding(acados::AcadosSolver & solver, Options const & options);
+
+  /**
+   * @brief Allocate the points of the message (and set the joint names and the time from start).
+   *
+   * @param msg Message to be prepared.
+   */
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  void prepare(trajectory_msgs::msg::JointTrajectory & msg) const;
+
+  /**
+   * @brief Write the current solution of the solver into a message prepared with `prepare()`.
+   *
+   * Only the bound fields are written, the header is left untouched. The message is checked before
+   * writing: the number of points and joints, as well as the size of each bound field of each point,
+   * must match the ones set by `prepare()`.
+   *
+   * @param solver Solver (same dimensions as at construction).
+   * @param msg Prepared message.
+   * @return false if the message was not prepared by this binding (nothing written).
+   */
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  bool fill(acados::AcadosSolver & solver, trajectory_msgs::msg::JointTrajectory & msg);
+
+  /// @brief Returns the number of points of the prepared messages.
+  ACADOS_MPC_CONTROLLER_PUBLIC
+  size_t num_points() const;
+
+private:
+  struct ResolvedField
+  {
+    Variable variable = Variable::STATE;
+    /// @brief Solver index of each joint (empty if the field is not bound).
+    std::vector<unsigned int> indexes;
+  };
+
+  /// @brief Resolve the keys of a field.
+  ResolvedField resolve(
+    acados::AcadosSolver & solver, FieldBinding const & field, std::string const & field_name) const;
+
+  /// @brief Returns true if the sizes of the message match the ones set by `prepare()`.
+  bool is_prepared(trajectory_msgs::msg::JointTrajectory const & msg) const;
+
+  /// @brief Copy the bound values of a stage into a field of a trajectory point.
+  void fill_field(ResolvedField const & field, std::vector<double> & values) const;
+
+  std::vector<std::string> _joint_names;
+  ResolvedField _positions, _velocities, _accelerations, _effort;
+  bool _needs_state = false, _needs_control = false;
+  size_t _num_points = 0;
+
+  /// @brief Time from start of each point (in seconds).
+  std::vector<double> _times;
+
+  /// @brief Values of the current stage (sizes nx and nu).
+  Eigen::VectorXd _x_k, _u_k;
+};
+
+}  // namespace acados_mpc_controller
+
+#endif  // ACADOS_MPC_CONTROLLER__TRAJECTORY_MSG_BINDING_HPP_
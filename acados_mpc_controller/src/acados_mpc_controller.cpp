@@ -0,0 +1,270 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_mpc_controller/acados_mpc_controller.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace acados_mpc_controller
+{
+
+using controller_interface::CallbackReturn;
+
+AcadosMpcController::AcadosMpcController()
+: controller_interface::ControllerInterface()
+{
+}
+
+controller_interface::CallbackReturn AcadosMpcController::on_init()
+{
+  try {
+    auto_declare<std::string>("solver_plugin", "");
+    auto_declare<int>("N", 10);
+    auto_declare<double>("Ts", 0.01);
+    auto_declare<std::vector<std::string>>("state_keys", std::vector<std::string>());
+    auto_declare<std::vector<std::string>>("state_interfaces", std::vector<std::string>());
+    auto_declare<std::vector<std::string>>("control_keys", std::vector<std::string>());
+    auto_declare<std::vector<std::string>>("command_interfaces", std::vector<std::string>());
+  } catch (const std::exception & e) {
+    fprintf(stderr, "Exception thrown during init stage with message: %s \n", e.what());
+    return CallbackReturn::ERROR;
+  }
+  return CallbackReturn::SUCCESS;
+}
+
+controller_interface::InterfaceConfiguration
+AcadosMpcController::command_interface_configuration() const
+{
+  return {controller_interface::interface_configuration_type::INDIVIDUAL, _command_interface_names};
+}
+
+controller_interface::InterfaceConfiguration
+AcadosMpcController::state_interface_configuration() const
+{
+  return {controller_interface::interface_configuration_type::INDIVIDUAL, _state_interface_names};
+}
+
+controller_interface::CallbackReturn AcadosMpcController::on_configure(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  auto logger = get_node()->get_logger();
+
+  // Read parameters
+  _solver_plugin = get_node()->get_parameter("solver_plugin").as_string();
+  const int N = get_node()->get_parameter("N").as_int();
+  const double Ts = get_node()->get_parameter("Ts").as_double();
+  _state_keys = get_node()->get_parameter("state_keys").as_string_array();
+  _state_interface_names = get_node()->get_parameter("state_interfaces").as_string_array();
+  _control_keys = get_node()->get_parameter("control_keys").as_string_array();
+  _command_interface_names = get_node()->get_parameter("command_interfaces").as_string_array();
+  if (_solver_plugin.empty() || N <= 0 || Ts <= 0.0) {
+    RCLCPP_ERROR(logger, "Invalid 'solver_plugin', 'N', or 'Ts' parameter!");
+    return CallbackReturn::ERROR;
+  }
+
+  // Load and initialize the solver
+  try {
+    if (!_solver_loader) {
+      _solver_loader = std::make_unique<pluginlib::ClassLoader<acados::AcadosSolver>>(
+        "acados_solver_base", "acados::AcadosSolver");
+    }
+    _solver = _solver_loader->createSharedInstance(_solver_plugin);
+  } catch (pluginlib::PluginlibException & ex) {
+    RCLCPP_ERROR(
+      logger, "Failed to load the solver plugin '%s': %s", _solver_plugin.c_str(), ex.what());
+    return CallbackReturn::ERROR;
+  }
+  if (_solver->init(static_cast<unsigned int>(N), Ts) != 0) {
+    RCLCPP_ERROR(logger, "Failed to initialize the solver plugin '%s'!", _solver_plugin.c_str());
+    return CallbackReturn::ERROR;
+  }
+
+  // Map the interfaces to the solver indexes (once and for all)
+  if (!map_interfaces(
+      _solver->x_index_map(), _state_keys, _state_interface_names, _state_indexes))
+  {
+    RCLCPP_ERROR(logger, "Invalid 'state_keys' / 'state_interfaces' parameters!");
+    return CallbackReturn::ERROR;
+  }
+  std::vector<bool> is_state_mapped(_solver->nx(), false);
+  for (unsigned int index : _state_indexes) {
+    is_state_mapped[index] = true;
+  }
+  for (unsigned int index = 0; index < _solver->nx(); index++) {
+    if (!is_state_mapped[index]) {
+      RCLCPP_ERROR(logger, "The state variable %u is not mapped to any state interface!", index);
+      return CallbackReturn::ERROR;
+    }
+  }
+  if (!map_interfaces(
+      _solver->u_index_map(), _control_keys, _command_interface_names, _command_indexes))
+  {
+    RCLCPP_ERROR(logger, "Invalid 'control_keys' / 'command_interfaces' parameters!");
+    return CallbackReturn::ERROR;
+  }
+
+  // Preallocate buffers
+  _x0.assign(_solver->nx(), 0.0);
+  _u0.assign(_solver->nu(), 0.0);
+  _p_buffer.writeFromNonRT(nullptr);
+  _last_applied_p.reset();
+
+  // Runtime parameters subscriber
+  _p_subscriber = get_node()->create_subscription<std_msgs::msg::Float64MultiArray>(
+    "~/runtime_parameters", rclcpp::SystemDefaultsQoS(),
+    [this](const std_msgs::msg::Float64MultiArray::SharedPtr msg) {
+      const Eigen::Index np = _solver->np();
+      const Eigen::Index size = static_cast<Eigen::Index>(msg->data.size());
+      if (np == 0 || size % np != 0) {
+        RCLCPP_WARN(get_node()->get_logger(), "Invalid size of the runtime parameters message!");
+        return;
+      }
+      acados::ColumnMajorXd p_traj =
+        Eigen::Map<const acados::ColumnMajorXd>(msg->data.data(), np, size / np);
+      if (!set_runtime_parameters_from_non_rt(p_traj)) {
+        RCLCPP_WARN(get_node()->get_logger(), "Invalid size of the runtime parameters message!");
+      }
+    });
+
+  RCLCPP_INFO(
+    logger, "Configured solver plugin '%s' (nx = %u, nu = %u, np = %u, N = %u).",
+    _solver_plugin.c_str(), _solver->nx(), _solver->nu(), _solver->np(), _solver->N());
+  return CallbackReturn::SUCCESS;
+}
+
+controller_interface::CallbackReturn AcadosMpcController::on_activate(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  if (state_interfaces_.size() != _state_indexes.size() ||
+    command_interfaces_.size() != _command_indexes.size())
+  {
+    RCLCPP_ERROR(get_node()->get_logger(), "Unexpected number of loaned interfaces!");
+    return CallbackReturn::ERROR;
+  }
+  _solver->reset();
+  return CallbackReturn::SUCCESS;
+}
+
+controller_interface::CallbackReturn AcadosMpcController::on_deactivate(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  return CallbackReturn::SUCCESS;
+}
+
+controller_interface::CallbackReturn AcadosMpcController::on_cleanup(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  _p_subscriber.reset();
+  _p_buffer.writeFromNonRT(nullptr);
+  _last_applied_p.reset();
+  _solver.reset();
+  return CallbackReturn::SUCCESS;
+}
+
+controller_interface::return_type AcadosMpcController::update(
+  const rclcpp::Time & time, const rclcpp::Duration & /*period*/)
+{
+  // Runtime parameters (only applied when updated)
+  std::shared_ptr<acados::ColumnMajorXd> p_traj = *_p_buffer.readFromRT();
+  if (p_traj && p_traj != _last_applied_p) {
+    _solver->set_runtime_parameters_trajectory(*p_traj);
+    _last_applied_p = p_traj;
+  }
+
+  // Initial state
+  for (size_t i = 0; i < state_interfaces_.size(); i++) {
+    _x0[_state_indexes[i]] = state_interfaces_[i].get_value();
+  }
+  _solver->set_initial_state_values(_x0);
+
+  // Solve
+  if (!before_solve(time)) {
+    return controller_interface::return_type::OK;
+  }
+  int status = _solver->solve();
+  if (!after_solve(time, status)) {
+    return controller_interface::return_type::OK;
+  }
+
+  // Commands
+  _solver->get_control_values_unchecked(0, _u0.data());
+  for (size_t i = 0; i < command_interfaces_.size(); i++) {
+    command_interfaces_[i].set_value(_u0[_command_indexes[i]]);
+  }
+  return controller_interface::return_type::OK;
+}
+
+bool AcadosMpcController::set_runtime_parameters_from_non_rt(acados::ColumnMajorXd const & p_traj)
+{
+  if (!_solver || p_traj.rows() != _solver->np() ||
+    (p_traj.cols() != 1 && p_traj.cols() != _solver->N() + 1))
+  {
+    return false;
+  }
+  auto p_traj_ptr = std::make_shared<acados::ColumnMajorXd>(
+    p_traj.replicate(1, (p_traj.cols() == 1) ? _solver->N() + 1 : 1));
+  _p_buffer.writeFromNonRT(p_traj_ptr);
+  return true;
+}
+
+bool AcadosMpcController::before_solve(const rclcpp::Time & /*time*/)
+{
+  return true;
+}
+
+bool AcadosMpcController::after_solve(const rclcpp::Time & /*time*/, int status)
+{
+  if (status != ACADOS_SUCCESS) {
+    RCLCPP_WARN_THROTTLE(
+      get_node()->get_logger(), *get_node()->get_clock(), 1000,
+      "The solver failed with status %d, the commands are not updated!", status);
+    return false;
+  }
+  return true;
+}
+
+acados::AcadosSolver & AcadosMpcController::solver()
+{
+  return *_solver;
+}
+
+bool AcadosMpcController::map_interfaces(
+  acados::IndexMap const & index_map,
+  std::vector<std::string> const & keys,
+  std::vector<std::string> const & interface_names,
+  std::vector<unsigned int> & indexes) const
+{
+  indexes.clear();
+  for (auto const & key : keys) {
+    auto it = index_map.find(key);
+    if (it == index_map.end()) {
+      RCLCPP_ERROR(get_node()->get_logger(), "Unknown key '%s'!", key.c_str());
+      return false;
+    }
+    indexes.insert(indexes.end(), it->second.begin(), it->second.end());
+  }
+  return indexes.size() == interface_names.size();
+}
+
+}  // namespace acados_mpc_controller
+
+#include "pluginlib/class_list_macros.hpp"
+
+PLUGINLIB_EXPORT_CLASS(
+  acados_mpc_controller::AcadosMpcController, controller_interface::ControllerInterface)
@@ -0,0 +1,267 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_mpc_controller/acados_solver_node.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace acados_mpc_controller
+{
+
+AcadosSolverNode::AcadosSolverNode(const rclcpp::NodeOptions & options)
+: rclcpp_lifecycle::LifecycleNode("acados_solver_node", options)
+{
+  declare_parameter<std::string>("solver_plugin", "");
+  declare_parameter<int>("N", 10);
+  declare_parameter<double>("Ts", 0.01);
+}
+
+AcadosSolverNode::~AcadosSolverNode()
+{
+  stop_solver_thread();
+}
+
+AcadosSolverNode::CallbackReturn AcadosSolverNode::on_configure(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  const std::string solver_plugin = get_parameter("solver_plugin").as_string();
+  const int N = get_parameter("N").as_int();
+  const double Ts = get_parameter("Ts").as_double();
+  if (solver_plugin.empty() || N <= 0 || Ts <= 0.0) {
+    RCLCPP_ERROR(get_logger(), "Invalid 'solver_plugin', 'N', or 'Ts' parameter!");
+    return CallbackReturn::FAILURE;
+  }
+
+  // Load and initialize the solver
+  try {
+    if (!_solver_loader) {
+      _solver_loader = std::make_unique<pluginlib::ClassLoader<acados::AcadosSolver>>(
+        "acados_solver_base", "acados::AcadosSolver");
+    }
+    _solver = _solver_loader->createSharedInstance(solver_plugin);
+  } catch (pluginlib::PluginlibException & ex) {
+    RCLCPP_ERROR(
+      get_logger(), "Failed to load the solver plugin '%s': %s", solver_plugin.c_str(), ex.what());
+    return CallbackReturn::FAILURE;
+  }
+  if (_solver->init(static_cast<unsigned int>(N), Ts) != 0) {
+    RCLCPP_ERROR(
+      get_logger(), "Failed to initialize the solver plugin '%s'!", solver_plugin.c_str());
+    return CallbackReturn::FAILURE;
+  }
+  const unsigned int nx = _solver->nx();
+  const unsigned int nu = _solver->nu();
+
+  // Preallocate buffers
+  _x0.assign(nx, 0.0);
+  _p.assign(_solver->np(), 0.0);
+  _pending_request.reserve(nx + _solver->np() * (N + 1));
+  _current_request.reserve(nx + _solver->np() * (N + 1));
+  // Layout of the state trajectory (row-major), the control trajectory follows it
+  _solution_msg.layout.data_offset = 2;
+  _solution_msg.layout.dim.resize(2);
+  _solution_msg.layout.dim[0].label = "stage";
+  _solution_msg.layout.dim[0].size = N + 1;
+  _solution_msg.layout.dim[0].stride = (N + 1) * nx;
+  _solution_msg.layout.dim[1].label = "x";
+  _solution_msg.layout.dim[1].size = nx;
+  _solution_msg.layout.dim[1].stride = nx;
+  _solution_msg.data.assign(2 + nx * (N + 1) + nu * N, 0.0);
+
+  // Time origin of the statistics until the activation (same clock as `now()`)
+  _activation_time = now();
+
+  // ROS interfaces
+  _request_subscriber = create_subscription<std_msgs::msg::Float64MultiArray>(
+    "~/solve_request", rclcpp::SystemDefaultsQoS(),
+    [this](const std_msgs::msg::Float64MultiArray::SharedPtr msg) {request_callback(msg);});
+  _solution_publisher = create_publisher<std_msgs::msg::Float64MultiArray>(
+    "~/solution", rclcpp::SystemDefaultsQoS());
+  _statistics_service = create_service<std_srvs::srv::Trigger>(
+    "~/get_statistics",
+    [this](
+      const std::shared_ptr<std_srvs::srv::Trigger::Request>/*request*/,
+      std::shared_ptr<std_srvs::srv::Trigger::Response> response)
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      const double elapsed_time = (now() - _activation_time).seconds();
+      char buffer[256];
+      std::snprintf(
+        buffer, sizeof(buffer),
+        "requests: %zu, coalesced: %zu, invalid: %zu, solves: %zu, failures: %zu, "
+        "mean solve time: %.3f ms, throughput: %.1f solves/s",
+        _num_requests, _num_coalesced, _num_invalid, _num_solves, _num_failures,
+        (_num_solves > 0) ? 1e3 * _total_solve_time / _num_solves : 0.0,
+        (elapsed_time > 0.0) ? _num_solves / elapsed_time : 0.0);
+      response->success = true;
+      response->message = buffer;
+    });
+
+  RCLCPP_INFO(
+    get_logger(), "Configured solver plugin '%s' (nx = %u, nu = %u, np = %u, N = %u).",
+    solver_plugin.c_str(), nx, nu, _solver->np(), _solver->N());
+  return CallbackReturn::SUCCESS;
+}
+
+AcadosSolverNode::CallbackReturn AcadosSolverNode::on_activate(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  _solution_publisher->on_activate();
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _has_pending_request = false;
+    _stop_requested = false;
+    _num_requests = _num_coalesced = _num_invalid = _num_solves = _num_failures = 0;
+    _total_solve_time = 0.0;
+    _activation_time = now();
+  }
+  _solver_thread = std::thread(&AcadosSolverNode::solver_loop, this);
+  return CallbackReturn::SUCCESS;
+}
+
+AcadosSolverNode::CallbackReturn AcadosSolverNode::on_deactivate(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  stop_solver_thread();
+  _solution_publisher->on_deactivate();
+  return CallbackReturn::SUCCESS;
+}
+
+AcadosSolverNode::CallbackReturn AcadosSolverNode::on_cleanup(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  _request_subscriber.reset();
+  _solution_publisher.reset();
+  _statistics_service.reset();
+  _solver.reset();
+  return CallbackReturn::SUCCESS;
+}
+
+AcadosSolverNode::CallbackReturn AcadosSolverNode::on_shutdown(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  stop_solver_thread();
+  return CallbackReturn::SUCCESS;
+}
+
+//####################################################################
+// Request coalescing
+//####################################################################
+
+void AcadosSolverNode::request_callback(const std_msgs::msg::Float64MultiArray::SharedPtr msg)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _num_requests++;
+    if (_has_pending_request) {
+      _num_coalesced++;
+    }
+    _pending_request = msg->data;
+    _has_pending_request = true;
+  }
+  _request_cv.notify_one();
+}
+
+void AcadosSolverNode::solver_loop()
+{
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _request_cv.wait(lock, [this] {return _stop_requested || _has_pending_request;});
+      if (_stop_requested) {
+        return;
+      }
+      std::swap(_current_request, _pending_request);
+      _has_pending_request = false;
+    }
+
+    if (!apply_request(_current_request)) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _num_invalid++;
+      continue;
+    }
+    const auto start_time = std::chrono::steady_clock::now();
+    int status = _solver->solve();
+    const double solve_time =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    fill_solution(status);
+    _solution_publisher->publish(_solution_msg);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _num_solves++;
+    _num_failures += (status != ACADOS_SUCCESS) ? 1 : 0;
+    _total_solve_time += solve_time;
+  }
+}
+
+void AcadosSolverNode::stop_solver_thread()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop_requested = true;
+  }
+  _request_cv.notify_all();
+  if (_solver_thread.joinable()) {
+    _solver_thread.join();
+  }
+}
+
+bool AcadosSolverNode::apply_request(std::vector<double> const & request)
+{
+  const size_t nx = _solver->nx();
+  const size_t np = _solver->np();
+  const size_t N = _solver->N();
+  if (request.size() != nx && request.size() != nx + np && request.size() != nx + np * (N + 1)) {
+    RCLCPP_WARN(
+      get_logger(), "Invalid request of size %zu (expected %zu, %zu, or %zu)!",
+      request.size(), nx, nx + np, nx + np * (N + 1));
+    return false;
+  }
+  _x0.assign(request.begin(), request.begin() + nx);
+  _solver->set_initial_state_values(_x0);
+  if (request.size() == nx + np) {
+    _p.assign(request.begin() + nx, request.end());
+    _solver->set_runtime_parameters(_p);
+  } else if (request.size() > nx + np) {
+    for (unsigned int stage = 0; stage <= N; stage++) {
+      _solver->set_runtime_parameters_unchecked(stage, request.data() + nx + stage * np);
+    }
+  }
+  return true;
+}
+
+void AcadosSolverNode::fill_solution(int status)
+{
+  const unsigned int nx = _solver->nx();
+  const unsigned int nu = _solver->nu();
+  const unsigned int N = _solver->N();
+  double * data = _solution_msg.data.data();
+  data[0] = static_cast<double>(status);
+  data[1] = _solver->solve_stats().time_tot;
+  for (unsigned int stage = 0; stage <= N; stage++) {
+    _solver->get_state_values_unchecked(stage, data + 2 + stage * nx);
+  }
+  for (unsigned int stage = 0; stage < N; stage++) {
+    _solver->get_control_values_unchecked(stage, data + 2 + (N + 1) * nx + stage * nu);
+  }
+}
+
+}  // namespace acados_mpc_controller
@@ -0,0 +1,166 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_mpc_controller/trajectory_msg_binding.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rclcpp/duration.hpp"
+
+namespace acados_mpc_controller
+{
+
+TrajectoryMsgBinding::TrajectoryMsgBinding(
+  acados::AcadosSolver & solver,
+  Options const & options)
+: _joint_names(options.joint_names)
+{
+  if (solver.N() == 0) {
+    throw std::invalid_argument(
+            "Error in 'TrajectoryMsgBinding::TrajectoryMsgBinding()': "
+            "the solver is not initialized!");
+  }
+  _positions = resolve(solver, options.positions, "positions");
+  _velocities = resolve(solver, options.velocities, "velocities");
+  _accelerations = resolve(solver, options.accelerations, "accelerations");
+  _effort = resolve(solver, options.effort, "effort");
+  for (ResolvedField const * field : {&_positions, &_velocities, &_accelerations, &_effort}) {
+    if (!field->indexes.empty()) {
+      _needs_state |= (field->variable == Variable::STATE);
+      _needs_control |= (field->variable == Variable::CONTROL);
+    }
+  }
+
+  // Time grid
+  _num_points = (options.capacity == 0) ?
+    solver.N() + 1 : std::min<size_t>(options.capacity, solver.N() + 1);
+  std::vector<double> sampling_intervals = solver.sampling_intervals();
+  _times.resize(_num_points);
+  _times[0] = 0.0;
+  for (size_t k = 1; k < _num_points; k++) {
+    _times[k] = _times[k - 1] + sampling_intervals[k - 1];
+  }
+  _x_k = Eigen::VectorXd::Zero(solver.nx());
+  _u_k = Eigen::VectorXd::Zero(solver.nu());
+}
+
+void TrajectoryMsgBinding::prepare(trajectory_msgs::msg::JointTrajectory & msg) const
+{
+  const size_t num_joints = _joint_names.size();
+  msg.joint_names = _joint_names;
+  msg.points.resize(_num_points);
+  for (size_t k = 0; k < _num_points; k++) {
+    trajectory_msgs::msg::JointTrajectoryPoint & point = msg.points[k];
+    point.positions.resize(_positions.indexes.empty() ? 0 : num_joints);
+    point.velocities.resize(_velocities.indexes.empty() ? 0 : num_joints);
+    point.accelerations.resize(_accelerations.indexes.empty() ? 0 : num_joints);
+    point.effort.resize(_effort.indexes.empty() ? 0 : num_joints);
+    point.time_from_start = rclcpp::Duration::from_seconds(_times[k]);
+  }
+}
+
+bool TrajectoryMsgBinding::fill(
+  acados::AcadosSolver & solver,
+  trajectory_msgs::msg::JointTrajectory & msg)
+{
+  if (!is_prepared(msg)) {
+    return false;
+  }
+  const unsigned int N = solver.N();
+  for (size_t k = 0; k < _num_points; k++) {
+    if (_needs_state) {
+      solver.get_state_values_unchecked(static_cast<unsigned int>(k), _x_k.data());
+    }
+    if (_needs_control) {
+      // The control is held at the terminal stage
+      solver.get_control_values_unchecked(
+        std::min(static_cast<unsigned int>(k), N - 1), _u_k.data());
+    }
+    trajectory_msgs::msg::JointTrajectoryPoint & point = msg.points[k];
+    fill_field(_positions, point.positions);
+    fill_field(_velocities, point.velocities);
+    fill_field(_accelerations, point.accelerations);
+    fill_field(_effort, point.effort);
+  }
+  return true;
+}
+
+bool TrajectoryMsgBinding::is_prepared(trajectory_msgs::msg::JointTrajectory const & msg) const
+{
+  if (msg.points.size() != _num_points || msg.joint_names.size() != _joint_names.size()) {
+    return false;
+  }
+  auto is_field_prepared = [](ResolvedField const & field, std::vector<double> const & values) {
+      return field.indexes.empty() || values.size() == field.indexes.size();
+    };
+  for (auto const & point : msg.points) {
+    if (!is_field_prepared(_positions, point.positions) ||
+      !is_field_prepared(_velocities, point.velocities) ||
+      !is_field_prepared(_accelerations, point.accelerations) ||
+      !is_field_prepared(_effort, point.effort))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t TrajectoryMsgBinding::num_points() const
+{
+  return _num_points;
+}
+
+TrajectoryMsgBinding::ResolvedField TrajectoryMsgBinding::resolve(
+  acados::AcadosSolver & solver,
+  FieldBinding const & field,
+  std::string const & field_name) const
+{
+  ResolvedField resolved_field;
+  resolved_field.variable = field.variable;
+  acados::IndexMap const & index_map = (field.variable == Variable::STATE) ?
+    solver.x_index_map() : solver.u_index_map();
+  for (auto const & key : field.keys) {
+    auto it = index_map.find(key);
+    if (it == index_map.end()) {
+      throw std::invalid_argument(
+              "Error in 'TrajectoryMsgBinding::TrajectoryMsgBinding()': unknown key '" + key +
+              "' for field '" + field_name + "'!");
+    }
+    resolved_field.indexes.insert(resolved_field.indexes.end(), it->second.begin(), it->second.end());
+  }
+  if (!resolved_field.indexes.empty() && resolved_field.indexes.size() != _joint_names.size()) {
+    throw std::invalid_argument(
+            "Error in 'TrajectoryMsgBinding::TrajectoryMsgBinding()': the number of variables bound "
+            "to field '" + field_name + "' does not match the number of joints!");
+  }
+  return resolved_field;
+}
+
+void TrajectoryMsgBinding::fill_field(
+  ResolvedField const & field,
+  std::vector<double> & values) const
+{
+  const Eigen::VectorXd & source = (field.variable == Variable::STATE) ? _x_k : _u_k;
+  for (size_t j = 0; j < field.indexes.size(); j++) {
+    values[j] = source[field.indexes[j]];
+  }
+}
+
+}  // namespace acados_mpc_controller
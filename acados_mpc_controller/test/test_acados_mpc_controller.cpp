@@ -0,0 +1,285 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "controller_manager/controller_manager.hpp"
+#include "controller_manager_msgs/srv/switch_controller.hpp"
+#include "hardware_interface/resource_manager.hpp"
+#include "pluginlib/class_loader.hpp"
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/float64_multi_array.hpp"
+
+#include "acados_solver_base/acados_solver.hpp"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+const char kControllerName[] = "test_acados_mpc_controller";
+const char kControllerType[] = "acados_mpc_controller/AcadosMpcController";
+
+// Mock solver plugin registered in the build tree of "acados_solver_base" (pendulum on a cart)
+const char kSolverPlugin[] = "acados_solver_base/MockAcadosSolver";
+
+// Cart-pole with mock hardware components (the commands are mirrored to the states of same name)
+const char kCartPoleUrdf[] =
+  R"(<?xml version="1.0"?>
+<robot name="cart_pole">
+  <link name="world"/>
+  <link name="cart"/>
+  <link name="pole"/>
+  <joint name="cart" type="prismatic">
+    <parent link="world"/>
+    <child link="cart"/>
+    <axis xyz="1 0 0"/>
+    <limit lower="-10.0" upper="10.0" effort="100.0" velocity="10.0"/>
+  </joint>
+  <joint name="pole" type="continuous">
+    <parent link="cart"/>
+    <child link="pole"/>
+    <axis xyz="0 1 0"/>
+    <limit effort="0.0" velocity="100.0"/>
+  </joint>
+  <ros2_control name="CartPole" type="system">
+    <hardware>
+      <plugin>mock_components/GenericSystem</plugin>
+    </hardware>
+    <joint name="cart">
+      <command_interface name="effort"/>
+      <state_interface name="position"><param name="initial_value">0.0</param></state_interface>
+      <state_interface name="velocity"><param name="initial_value">0.0</param></state_interface>
+      <state_interface name="effort"><param name="initial_value">0.0</param></state_interface>
+    </joint>
+    <joint name="pole">
+      <state_interface name="position"><param name="initial_value">0.1</param></state_interface>
+      <state_interface name="velocity"><param name="initial_value">0.0</param></state_interface>
+    </joint>
+  </ros2_control>
+</robot>
+)";
+
+/// @brief Controller manager giving access to the hardware interfaces.
+class TestableControllerManager : public controller_manager::ControllerManager
+{
+public:
+  using controller_manager::ControllerManager::ControllerManager;
+
+  /// @brief Returns the value of a state interface (e.g., a mirrored command).
+  double state_value(std::string const & name)
+  {
+    return resource_manager_->claim_state_interface(name).get_value();
+  }
+};
+
+}  // namespace
+
+class TestAcadosMpcController : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    executor_ = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+#if CONTROLLER_MANAGER_VERSION_MAJOR >= 4
+    cm_ = std::make_shared<TestableControllerManager>(
+      executor_, kCartPoleUrdf, true, "test_controller_manager");
+#else
+    cm_ = std::make_shared<TestableControllerManager>(
+      std::make_unique<hardware_interface::ResourceManager>(kCartPoleUrdf, true, true),
+      executor_, "test_controller_manager");
+#endif
+  }
+
+  /// @brief Load a controller and set its parameters (the solver plugin being the mock solver).
+  controller_interface::ControllerInterfaceBaseSharedPtr load_controller(
+    std::vector<std::string> const & state_keys,
+    std::vector<std::string> const & state_interfaces)
+  {
+    auto controller = cm_->load_controller(kControllerName, kControllerType);
+    if (controller) {
+      auto node = controller->get_node();
+      node->set_parameter(rclcpp::Parameter("solver_plugin", kSolverPlugin));
+      node->set_parameter(rclcpp::Parameter("N", 20));
+      node->set_parameter(rclcpp::Parameter("Ts", 0.05));
+      node->set_parameter(rclcpp::Parameter("state_keys", state_keys));
+      node->set_parameter(rclcpp::Parameter("state_interfaces", state_interfaces));
+      node->set_parameter(
+        rclcpp::Parameter("control_keys", std::vector<std::string>{"f"}));
+      node->set_parameter(
+        rclcpp::Parameter("command_interfaces", std::vector<std::string>{"cart/effort"}));
+    }
+    return controller;
+  }
+
+  /// @brief Load and configure the controller with all the state variables mapped.
+  controller_interface::ControllerInterfaceBaseSharedPtr load_and_configure_controller()
+  {
+    auto controller = load_controller(
+      {"p", "p_dot", "theta", "theta_dot"},
+      {"cart/position", "cart/velocity", "pole/position", "pole/velocity"});
+    if (!controller ||
+      cm_->configure_controller(kControllerName) != controller_interface::return_type::OK)
+    {
+      return nullptr;
+    }
+    return controller;
+  }
+
+  /// @brief Activate the controller (the switch is processed by the update loop).
+  controller_interface::return_type activate_controller()
+  {
+    auto switch_future = std::async(
+      std::launch::async, [this]() {
+        return cm_->switch_controller(
+          {kControllerName}, {},
+          controller_manager_msgs::srv::SwitchController::Request::STRICT);
+      });
+    while (switch_future.wait_for(10ms) != std::future_status::ready) {
+      cm_->update(cm_->now(), kPeriod);
+    }
+    return switch_future.get();
+  }
+
+  /// @brief Run a control cycle (read, update, write) and read back the mirrored command.
+  double control_cycle()
+  {
+    cm_->read(cm_->now(), kPeriod);
+    cm_->update(cm_->now(), kPeriod);
+    cm_->write(cm_->now(), kPeriod);
+    cm_->read(cm_->now(), kPeriod);
+    return cm_->state_value("cart/effort");
+  }
+
+  /// @brief Control of stage 0 of a cold-start reference solve from the initial states of the URDF.
+  double reference_control(acados::ValueVector const & p = {})
+  {
+    pluginlib::ClassLoader<acados::AcadosSolver> loader(
+      "acados_solver_base", "acados::AcadosSolver");
+    auto solver = loader.createSharedInstance(kSolverPlugin);
+    EXPECT_EQ(solver->init(20, 0.05), 0);
+    acados::ValueVector x0 {0.0, 0.0, 0.1, 0.0};
+    acados::ValueVector p_all = p;
+    if (!p_all.empty()) {
+      solver->set_runtime_parameters(p_all);
+    }
+    solver->set_initial_state_values(x0);
+    EXPECT_EQ(solver->solve(), 0);
+    return solver->get_control_values(0)[0];
+  }
+
+  const rclcpp::Duration kPeriod = rclcpp::Duration::from_seconds(0.01);
+  std::shared_ptr<rclcpp::Executor> executor_;
+  std::shared_ptr<TestableControllerManager> cm_;
+};
+
+TEST_F(TestAcadosMpcController, load_controller)
+{
+  ASSERT_NE(cm_->load_controller(kControllerName, kControllerType), nullptr);
+}
+
+TEST_F(TestAcadosMpcController, configure_controller)
+{
+  auto controller = load_and_configure_controller();
+  ASSERT_NE(controller, nullptr);
+
+  // Interfaces claimed in the order of the configuration
+  auto state_config = controller->state_interface_configuration();
+  ASSERT_EQ(
+    state_config.names,
+    std::vector<std::string>(
+      {"cart/position", "cart/velocity", "pole/position", "pole/velocity"}));
+  ASSERT_EQ(
+    controller->command_interface_configuration().names, std::vector<std::string>{"cart/effort"});
+}
+
+TEST_F(TestAcadosMpcController, configure_fails_with_unmapped_state_variable)
+{
+  // "theta_dot" is not mapped to any state interface
+  ASSERT_NE(
+    load_controller({"p", "p_dot", "theta"}, {"cart/position", "cart/velocity", "pole/position"}),
+    nullptr);
+  ASSERT_EQ(
+    cm_->configure_controller(kControllerName), controller_interface::return_type::ERROR);
+}
+
+TEST_F(TestAcadosMpcController, configure_fails_with_unknown_key)
+{
+  ASSERT_NE(
+    load_controller(
+      {"p", "p_dot", "theta", "omega"},
+      {"cart/position", "cart/velocity", "pole/position", "pole/velocity"}),
+    nullptr);
+  ASSERT_EQ(
+    cm_->configure_controller(kControllerName), controller_interface::return_type::ERROR);
+}
+
+TEST_F(TestAcadosMpcController, activate_and_update)
+{
+  ASSERT_NE(load_and_configure_controller(), nullptr);
+  ASSERT_EQ(activate_controller(), controller_interface::return_type::OK);
+
+  // The state interfaces are read as initial state, the control of stage 0 is commanded
+  const double u_0 = control_cycle();
+  ASSERT_NE(u_0, 0.0);
+  ASSERT_NEAR(u_0, reference_control(), 1e-6);
+}
+
+TEST_F(TestAcadosMpcController, runtime_parameters)
+{
+  auto controller = load_and_configure_controller();
+  ASSERT_NE(controller, nullptr);
+  ASSERT_EQ(activate_controller(), controller_interface::return_type::OK);
+
+  // Parameters of all stages, handed to the update loop through the realtime buffer
+  auto node = std::make_shared<rclcpp::Node>("test_parameters_publisher");
+  auto publisher = node->create_publisher<std_msgs::msg::Float64MultiArray>(
+    std::string("/") + kControllerName + "/runtime_parameters", rclcpp::SystemDefaultsQoS());
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (publisher->get_subscription_count() == 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(10ms);
+  }
+  ASSERT_GT(publisher->get_subscription_count(), 0u);
+  std_msgs::msg::Float64MultiArray msg;
+  msg.data = {2.0, 0.1};
+  publisher->publish(msg);
+  for (int i = 0; i < 20; i++) {
+    executor_->spin_some(10ms);
+  }
+
+  const double u_0 = control_cycle();
+  ASSERT_NEAR(u_0, reference_control({2.0, 0.1}), 1e-6);
+  ASSERT_GT(std::abs(u_0 - reference_control()), 1e-6);
+}
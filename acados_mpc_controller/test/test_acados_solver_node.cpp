@@ -0,0 +1,136 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lifecycle_msgs/msg/state.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "acados_mpc_controller/acados_solver_node.hpp"
+
+using namespace std::chrono_literals;
+
+class TestAcadosSolverNode : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    // Mock solver plugin registered in the build tree of "acados_solver_base" (pendulum on a cart)
+    rclcpp::NodeOptions options;
+    options.parameter_overrides(
+    {
+      rclcpp::Parameter("solver_plugin", "acados_solver_base/MockAcadosSolver"),
+      rclcpp::Parameter("N", 20),
+      rclcpp::Parameter("Ts", 0.05),
+    });
+    node_ = std::make_shared<acados_mpc_controller::AcadosSolverNode>(options);
+    client_node_ = std::make_shared<rclcpp::Node>("test_client");
+    executor_.add_node(node_->get_node_base_interface());
+    executor_.add_node(client_node_);
+  }
+
+  void TearDown() override
+  {
+    executor_.remove_node(client_node_);
+    executor_.remove_node(node_->get_node_base_interface());
+  }
+
+  /// @brief Call `~/get_statistics` (returns an empty string on failure).
+  std::string get_statistics()
+  {
+    auto client = client_node_->create_client<std_srvs::srv::Trigger>(
+      "/acados_solver_node/get_statistics");
+    if (!client->wait_for_service(1s)) {
+      return "";
+    }
+    auto future = client->async_send_request(std::make_shared<std_srvs::srv::Trigger::Request>());
+    if (executor_.spin_until_future_complete(future, 5s) != rclcpp::FutureReturnCode::SUCCESS) {
+      return "";
+    }
+    return future.get()->success ? future.get()->message : "";
+  }
+
+  rclcpp::executors::SingleThreadedExecutor executor_;
+  std::shared_ptr<acados_mpc_controller::AcadosSolverNode> node_;
+  rclcpp::Node::SharedPtr client_node_;
+};
+
+TEST_F(TestAcadosSolverNode, statistics_before_activation)
+{
+  ASSERT_EQ(node_->configure().id(), lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE);
+  ASSERT_THAT(get_statistics(), ::testing::HasSubstr("solves: 0"));
+}
+
+TEST_F(TestAcadosSolverNode, solve_request)
+{
+  ASSERT_EQ(node_->configure().id(), lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE);
+  ASSERT_EQ(node_->activate().id(), lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE);
+
+  std_msgs::msg::Float64MultiArray::SharedPtr solution;
+  auto subscription = client_node_->create_subscription<std_msgs::msg::Float64MultiArray>(
+    "/acados_solver_node/solution", rclcpp::SystemDefaultsQoS(),
+    [&solution](const std_msgs::msg::Float64MultiArray::SharedPtr msg) {solution = msg;});
+  auto publisher = client_node_->create_publisher<std_msgs::msg::Float64MultiArray>(
+    "/acados_solver_node/solve_request", rclcpp::SystemDefaultsQoS());
+
+  // Initial state followed by the parameters of all stages (resent until the node answers)
+  std_msgs::msg::Float64MultiArray request;
+  request.data = {0.0, 0.0, 0.1, 0.0, 1.0, 0.1};
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (!solution && std::chrono::steady_clock::now() < deadline) {
+    publisher->publish(request);
+    executor_.spin_some(10ms);
+  }
+  ASSERT_NE(solution, nullptr);
+
+  // Layout of the state trajectory (nx = 4, nu = 1), followed by the control trajectory
+  const size_t nx = 4, nu = 1, N = 20;
+  ASSERT_EQ(solution->layout.data_offset, 2u);
+  ASSERT_EQ(solution->layout.dim.size(), 2u);
+  ASSERT_EQ(solution->layout.dim[0].size, N + 1);
+  ASSERT_EQ(solution->layout.dim[0].stride, (N + 1) * nx);
+  ASSERT_EQ(solution->layout.dim[1].size, nx);
+  ASSERT_EQ(solution->layout.dim[1].stride, nx);
+  ASSERT_EQ(solution->data.size(), 2 + (N + 1) * nx + N * nu);
+  ASSERT_EQ(solution->data[0], 0.0);  // Status
+  for (size_t i = 0; i < nx; i++) {
+    ASSERT_NEAR(solution->data[2 + i], request.data[i], 1e-6);
+  }
+
+  ASSERT_EQ(node_->deactivate().id(), lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE);
+  ASSERT_THAT(get_statistics(), ::testing::Not(::testing::HasSubstr("solves: 0")));
+}
+
+TEST_F(TestAcadosSolverNode, configure_fails_with_unknown_plugin)
+{
+  node_->set_parameter(rclcpp::Parameter("solver_plugin", "acados_solver_base/UnknownSolver"));
+  ASSERT_EQ(node_->configure().id(), lifecycle_msgs::msg::State::PRIMARY_STATE_UNCONFIGURED);
+}
@@ -0,0 +1,128 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "pluginlib/class_loader.hpp"
+#include "rclcpp/duration.hpp"
+
+#include "acados_mpc_controller/trajectory_msg_binding.hpp"
+
+using acados_mpc_controller::TrajectoryMsgBinding;
+
+class TestTrajectoryMsgBinding : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Mock solver plugin registered in the build tree of "acados_solver_base" (pendulum on a cart)
+    loader_ = std::make_unique<pluginlib::ClassLoader<acados::AcadosSolver>>(
+      "acados_solver_base", "acados::AcadosSolver");
+    solver_ = loader_->createSharedInstance("acados_solver_base/MockAcadosSolver");
+    ASSERT_EQ(solver_->init(20, 0.05), 0);
+    acados::ValueVector p {1.0, 0.1};
+    acados::ValueVector x0 {0.0, 0.0, 0.1, 0.0};
+    solver_->set_runtime_parameters(p);
+    solver_->set_initial_state_values(x0);
+    ASSERT_EQ(solver_->solve(), 0);
+
+    options_.joint_names = {"cart"};
+    options_.positions = {TrajectoryMsgBinding::Variable::STATE, {"p"}};
+    options_.velocities = {TrajectoryMsgBinding::Variable::STATE, {"p_dot"}};
+    options_.effort = {TrajectoryMsgBinding::Variable::CONTROL, {"f"}};
+  }
+
+  std::unique_ptr<pluginlib::ClassLoader<acados::AcadosSolver>> loader_;
+  std::shared_ptr<acados::AcadosSolver> solver_;
+  TrajectoryMsgBinding::Options options_;
+};
+
+TEST_F(TestTrajectoryMsgBinding, prepare_and_fill)
+{
+  TrajectoryMsgBinding binding(*solver_, options_);
+  ASSERT_EQ(binding.num_points(), 21u);
+
+  trajectory_msgs::msg::JointTrajectory msg;
+  binding.prepare(msg);
+  ASSERT_EQ(msg.joint_names, options_.joint_names);
+  ASSERT_EQ(msg.points.size(), 21u);
+  ASSERT_EQ(msg.points[0].positions.size(), 1u);
+  ASSERT_TRUE(msg.points[0].accelerations.empty());
+  ASSERT_NEAR(rclcpp::Duration(msg.points[20].time_from_start).seconds(), 1.0, 1e-9);
+
+  ASSERT_TRUE(binding.fill(*solver_, msg));
+  for (unsigned int stage = 0; stage <= 20; stage++) {
+    acados::ValueVector x = solver_->get_state_values(stage);
+    acados::ValueVector u = solver_->get_control_values(std::min(stage, 19u));
+    ASSERT_DOUBLE_EQ(msg.points[stage].positions[0], x[0]);
+    ASSERT_DOUBLE_EQ(msg.points[stage].velocities[0], x[1]);
+    ASSERT_DOUBLE_EQ(msg.points[stage].effort[0], u[0]);
+  }
+}
+
+TEST_F(TestTrajectoryMsgBinding, capacity)
+{
+  options_.capacity = 5;
+  TrajectoryMsgBinding binding(*solver_, options_);
+  trajectory_msgs::msg::JointTrajectory msg;
+  binding.prepare(msg);
+  ASSERT_EQ(msg.points.size(), 5u);
+  ASSERT_TRUE(binding.fill(*solver_, msg));
+}
+
+TEST_F(TestTrajectoryMsgBinding, invalid_options)
+{
+  TrajectoryMsgBinding::Options options = options_;
+  options.positions.keys = {"omega"};
+  ASSERT_THROW(TrajectoryMsgBinding binding(*solver_, options), std::invalid_argument);
+
+  // Two variables bound to a single joint
+  options = options_;
+  options.positions.keys = {"p", "theta"};
+  ASSERT_THROW(TrajectoryMsgBinding binding(*solver_, options), std::invalid_argument);
+}
+
+TEST_F(TestTrajectoryMsgBinding, fill_refuses_mismatched_message)
+{
+  TrajectoryMsgBinding binding(*solver_, options_);
+  trajectory_msgs::msg::JointTrajectory msg;
+  binding.prepare(msg);
+
+  // Bound field resized after prepare()
+  msg.points[3].velocities.clear();
+  msg.points[0].positions[0] = -1.0;
+  ASSERT_FALSE(binding.fill(*solver_, msg));
+  ASSERT_EQ(msg.points[0].positions[0], -1.0);  // Nothing written
+
+  // Unbound fields are not checked
+  binding.prepare(msg);
+  msg.points[3].accelerations.resize(4);
+  ASSERT_TRUE(binding.fill(*solver_, msg));
+
+  // Wrong number of points or joints
+  binding.prepare(msg);
+  msg.points.pop_back();
+  ASSERT_FALSE(binding.fill(*solver_, msg));
+  binding.prepare(msg);
+  msg.joint_names.push_back("pole");
+  ASSERT_FALSE(binding.fill(*solver_, msg));
+}
@@ -25,6 +25,9 @@
 
 #include "acados_solver_base/visibility_control.h"
 #include "acados_solver_base/acados_types.hpp"
+#include "acados_solver_base/acados_solver_logging.hpp"
+#include "acados_solver_base/flat_index_map.hpp"
+#include "acados_solver_base/named_vector.hpp"
 
 
 // Acados C interface
@@ -152,6 +155,89 @@ public:
     unsigned int nr;
   };
 
+  class SolveStats
+    /**
+    * @brief Container for the statistics of the last `solve()` or `solve_rti()` call.
+    *
+    * Filled from `ocp_nlp_get()` after each solve, without any allocation.
+    * With an RTI solver, the timings of `solve()` include both the preparation and feedback stages,
+    * whereas those of `solve_rti()` only cover the requested stage.
+    */
+  {
+public:
+    // Timings (in seconds)
+
+    /// @brief Total CPU time of the last solve
+    double time_tot = 0.0;
+
+    /// @brief CPU time spent in the linearization
+    double time_lin = 0.0;
+
+    /// @brief CPU time spent in the QP solver
+    double time_qp = 0.0;
+
+    /// @brief CPU time spent in the regularization
+    double time_reg = 0.0;
+
+    // Iterations
+
+    /// @brief Number of SQP iterations
+    int sqp_iter = 0;
+
+    /// @brief Number of QP solver iterations (last SQP iteration)
+    int qp_iter = 0;
+
+    // Residuals
+
+    /// @brief Stationarity residual
+    double res_stat = 0.0;
+
+    /// @brief Equality constraints residual
+    double res_eq = 0.0;
+
+    /// @brief Inequality constraints residual
+    double res_ineq = 0.0;
+
+    /// @brief Complementarity residual
+    double res_comp = 0.0;
+
+    // Status
+
+    /// @brief Acados status returned by the last solve (see `solve()`)
+    int status = -1;
+  };
+
+  class Iterate
+    /**
+    * @brief Container for the full primal-dual iterate stored in `ocp_nlp_out` (one vector per stage).
+    *
+    * Use `create_iterate()` to allocate the buffers once, then `get_iterate()` and `set_iterate()`
+    * to copy the iterate without allocation (e.g., to warm-start another solver instance).
+    */
+  {
+public:
+    /// @brief Differential states, stages 0 to N
+    std::vector<Eigen::VectorXd> x;
+
+    /// @brief Controls, stages 0 to N (empty at stage N)
+    std::vector<Eigen::VectorXd> u;
+
+    /// @brief Algebraic states, stages 0 to N
+    std::vector<Eigen::VectorXd> z;
+
+    /// @brief Multipliers of the dynamics, stages 0 to N-1
+    std::vector<Eigen::VectorXd> pi;
+
+    /// @brief Multipliers of the inequality constraints, stages 0 to N
+    std::vector<Eigen::VectorXd> lam;
+
+    /// @brief Lower slack variables, stages 0 to N
+    std::vector<Eigen::VectorXd> sl;
+
+    /// @brief Upper slack variables, stages 0 to N
+    std::vector<Eigen::VectorXd> su;
+  };
+
 public:
 // Acados solver public API
 
@@ -226,6 +312,36 @@ public:
    */
   int solve_rti(RtiStage rti_phase);
 
+  /**
+   * @brief Returns the statistics of the last `solve()` or `solve_rti()` call.
+   *
+   * Unlike `internal_print_stats()`, nothing is written to the console.
+   *
+   * @return const SolveStats& The statistics
+   */
+  const SolveStats & solve_stats() const;
+
+  /**
+   * @brief Configure the compensation of the computation delay in `set_initial_state_values()`.
+   *
+   * With `DelayCompensation::MEASURED`, the latency is the total time of the last solve (see `solve_stats()`,
+   * i.e., both RTI stages for `solve()` but only the requested stage for `solve_rti()`);
+   * with `DelayCompensation::CONFIGURED`, it is the provided `latency`.
+   *
+   * @note The unchecked setter `set_initial_state_values_unchecked()` is never compensated.
+   *
+   * @param mode Delay compensation mode.
+   * @param latency Configured latency in seconds (only used with `DelayCompensation::CONFIGURED`).
+   */
+  void set_delay_compensation(DelayCompensation mode, double latency = 0.0);
+
+  /**
+   * @brief Returns the latency (in seconds) currently used to predict the initial state, zero if disabled.
+   *
+   * @return double
+   */
+  double delay_compensation_latency() const;
+
 // Simulation
 
   /**
@@ -272,11 +388,39 @@ public:
     ValueMap & z_map
   );
 
+  /**
+   * @brief Simulate the next state and its forward sensitivities w.r.t. the state and controls.
+   *
+   * The sensitivities are computed by the integrator of the plugin (i.e., `S_forw` of the acados sim
+   * solver), which avoids finite differencing (e.g., for EKF/UKF estimators or linearized feedback).
+   * The output matrices must be preallocated, no memory is allocated by this method.
+   *
+   * @param dx_next_dx0 Jacobian of the next state w.r.t. the initial state (size nx x nx).
+   * @param dx_next_du Jacobian of the next state w.r.t. the controls (size nx x nu).
+   * @return 0 : All OK.
+   * @return 13 : The plugin does not support forward sensitivities (generated with an older template).
+   * @return other : Not OK. See `simulate()` and the Acados documentation for details.
+   */
+  int simulate_with_sensitivities(
+    double dt,
+    ValueVector & x0,
+    ValueVector & u0,
+    ValueVector & p,
+    ValueVector & x_next,
+    ValueVector & z,
+    ColumnMajorXd & dx_next_dx0,
+    ColumnMajorXd & dx_next_du
+  );
+
 // Setters
 
   /**
    * @brief Set the initial state values (i.e., add constraints on initial state)
    *
+   * If the delay compensation is enabled (see `set_delay_compensation()`), the measured state `x_0` is first
+   * predicted over the solve latency with `simulate()`, using the control of the first stage of the current
+   * solution (i.e., the control being applied while the solver runs) and the runtime parameters of stage 0.
+   *
    * @param x_0 State values at initial stage.
    * @return int (zero if all OK)
    */
@@ -290,6 +434,14 @@ public:
    */
   int set_initial_state_values(ValueMap const & x_0_map);
 
+  /**
+   * @brief Set the initial state values from a NamedVector (see `x_named_vector()`), without allocation.
+   *
+   * @param x_0 NamedVector of the initial state values.
+   * @return int (zero if all OK)
+   */
+  int set_initial_state_values(NamedVector const & x_0);
+
   /**
    * @brief Set (differential) state bounds at a given stage.
    *
@@ -349,6 +501,49 @@ public:
     ValueVector & lbu,
     ValueVector & ubu);
 
+  /**
+   * @brief Set time-varying (differential) state bounds over a range of stages in a single call.
+   *
+   * The i-th column of `lbx_traj` and `ubx_traj` is written to stage `first_stage + i`.
+   * All dimensions are checked before any value is written to the solver.
+   *
+   * @throws std::range_error if the dimensions are inconsistent.
+   *
+   * @param first_stage First stage of the range, in [0;N].
+   * @param idxbx Indexes of the bounded state variables (same for all stages of the range).
+   * @param lbx_traj Matrix of lower bounds of size (idxbx.size(), number of stages).
+   * @param ubx_traj Matrix of upper bounds of size (idxbx.size(), number of stages).
+   * @param only_changed If true, the stages whose bounds did not change since the last call are skipped.
+   * @return int (zero if all OK)
+   */
+  int set_state_bounds_trajectory(
+    unsigned int first_stage,
+    IndexVector & idxbx,
+    ColumnMajorXd const & lbx_traj,
+    ColumnMajorXd const & ubx_traj,
+    bool only_changed = false);
+
+  /**
+   * @brief Set time-varying control bounds over a range of stages in a single call.
+   *
+   * See `set_state_bounds_trajectory()` for details.
+   *
+   * @throws std::range_error if the dimensions are inconsistent.
+   *
+   * @param first_stage First stage of the range, in [0;N-1].
+   * @param idxbu Indexes of the bounded control variables (same for all stages of the range).
+   * @param lbu_traj Matrix of lower bounds of size (idxbu.size(), number of stages).
+   * @param ubu_traj Matrix of upper bounds of size (idxbu.size(), number of stages).
+   * @param only_changed If true, the stages whose bounds did not change since the last call are skipped.
+   * @return int (zero if all OK)
+   */
+  int set_control_bounds_trajectory(
+    unsigned int first_stage,
+    IndexVector & idxbu,
+    ColumnMajorXd const & lbu_traj,
+    ColumnMajorXd const & ubu_traj,
+    bool only_changed = false);
+
 // Runtime parameters
 
   /**
@@ -371,6 +566,15 @@ public:
    */
   int set_runtime_parameters(unsigned int stage, ValueMap const & p_i_map);
 
+  /**
+   * @brief Set the runtime parameters for one stage from a NamedVector (see `p_named_vector()`), without allocation.
+   *
+   * @param stage Stage in [0;N].
+   * @param p_i NamedVector containing the runtime parameters.
+   * @return int Status (zero if all OK).
+   */
+  int set_runtime_parameters(unsigned int stage, NamedVector const & p_i);
+
 
   /**
    * @brief Set the runtime parameters for all stages at once from ordered value vector.
@@ -393,6 +597,35 @@ public:
    */
   int set_runtime_parameters(ValueMap const & p_i_map);
 
+  /**
+   * @brief Set the runtime parameters for all stages at once from a NamedVector (see `p_named_vector()`).
+   *
+   * @param p_i NamedVector containing the runtime parameters.
+   * @return int Status (zero if all OK).
+   */
+  int set_runtime_parameters(NamedVector const & p_i);
+
+  /**
+   * @brief Set time-varying runtime parameters for all stages at once.
+   *
+   * The size of `p_traj` is checked once, then each column is written to the corresponding stage.
+   *
+   * @param p_traj Matrix of size (np, N+1) whose i-th column contains the (ordered) runtime parameters of stage i.
+   * @return int Status (zero if all OK).
+   */
+  int set_runtime_parameters_trajectory(ColumnMajorXd const & p_traj);
+
+  /**
+   * @brief Set the time-varying values of a single runtime parameter (e.g., a reference) for all stages at once.
+   *
+   * Only the indexes of `p_index_map().at(key)` are updated, using the sparse parameter update of the solver.
+   *
+   * @param key Name of the runtime parameter (see `p_index_map()`).
+   * @param values_traj Matrix of size (p_index_map().at(key).size(), N+1) whose i-th column contains the values at stage i.
+   * @return int Status (zero if all OK).
+   */
+  int set_runtime_parameters_trajectory(std::string const & key, ColumnMajorXd const & values_traj);
+
 // Initialization state
 
   /**
@@ -419,6 +652,15 @@ public:
    */
   int initialize_state_values(unsigned int stage, ValueMap const & x_i_map);
 
+  /**
+   * @brief Initialize the (differential) state values for a stage from a NamedVector (see `x_named_vector()`).
+   *
+   * @param stage Stage in [0;N].
+   * @param x_i NamedVector containing the initial state values.
+   * @return int Status (zero if all OK).
+   */
+  int initialize_state_values(unsigned int stage, NamedVector const & x_i);
+
   /**
     * @brief Initialize the (differential) state values for ALL stages at once from an ordered value vector.
     *
@@ -435,6 +677,14 @@ public:
    */
   int initialize_state_values(ValueMap const & x_i_map);
 
+  /**
+   * @brief Initialize the (differential) state values for ALL stages at once from a NamedVector.
+   *
+   * @param x_i NamedVector containing the initial state values.
+   * @return int Status (zero if all OK).
+   */
+  int initialize_state_values(NamedVector const & x_i);
+
 // Initialization controls
 
   /**
@@ -455,6 +705,15 @@ public:
    */
   int initialize_control_values(unsigned int stage, ValueMap const & u_i_map);
 
+  /**
+   * @brief Initialize the control variable values for one stage from a NamedVector (see `u_named_vector()`).
+   *
+   * @param stage Stage in [0;N-1].
+   * @param u_i NamedVector containing the control variables values.
+   * @return int Status (zero if all OK).
+   */
+  int initialize_control_values(unsigned int stage, NamedVector const & u_i);
+
   /**
    * @brief Initialize the control variable values for ALL stages at once from an ordered value vector.
    *
@@ -471,6 +730,14 @@ public:
    */
   int initialize_control_values(ValueMap const & u_i_map);
 
+  /**
+   * @brief Initialize the control variable values for ALL stages at once from a NamedVector.
+   *
+   * @param u_i NamedVector containing the control variables values.
+   * @return int Status (zero if all OK).
+   */
+  int initialize_control_values(NamedVector const & u_i);
+
 // Getters
   /**
    * @brief Retrieve the differential state variables at a given stage.
@@ -488,6 +755,17 @@ public:
    */
   ValueMap get_state_values_as_map(unsigned int stage);
 
+  /**
+   * @brief Retrieve the differential state variables at a given stage into a NamedVector (see `x_named_vector()`), without allocation.
+   *
+   * @throws std::range_error if the stage is invalid.
+   * @throws std::invalid_argument if the layout of `values` is not the one of `x_named_vector()`.
+   *
+   * @param[in] stage Stage in [0;N].
+   * @param[out] values NamedVector receiving the values.
+   */
+  void get_state_values_as_map(unsigned int stage, NamedVector & values);
+
   /**
    * @brief Retrieve the algebraic state variables at a given stage.
    *
@@ -505,6 +783,17 @@ public:
    */
   ValueMap get_algebraic_state_values_as_map(unsigned int stage);
 
+  /**
+   * @brief Retrieve the algebraic state variables at a given stage into a NamedVector (see `z_named_vector()`), without allocation.
+   *
+   * @throws std::range_error if the stage is invalid.
+   * @throws std::invalid_argument if the layout of `values` is not the one of `z_named_vector()`.
+   *
+   * @param[in] stage Stage in [0;N].
+   * @param[out] values NamedVector receiving the values.
+   */
+  void get_algebraic_state_values_as_map(unsigned int stage, NamedVector & values);
+
   /**
    * @brief Retrieve the control variables at a given stage.
    *
@@ -521,6 +810,17 @@ public:
    */
   ValueMap get_control_values_as_map(unsigned int stage);
 
+  /**
+   * @brief Retrieve the control variables at a given stage into a NamedVector (see `u_named_vector()`), without allocation.
+   *
+   * @throws std::range_error if the stage is invalid.
+   * @throws std::invalid_argument if the layout of `values` is not the one of `u_named_vector()`.
+   *
+   * @param[in] stage Stage in [0;N].
+   * @param[out] values NamedVector receiving the values.
+   */
+  void get_control_values_as_map(unsigned int stage, NamedVector & values);
+
   /**
    * @brief Retrieve the parameters at a given stage.
    *
@@ -537,6 +837,190 @@ public:
    */
   ValueMap get_parameter_values_as_map(unsigned int stage);
 
+  /**
+   * @brief Retrieve the parameters at a given stage into a NamedVector (see `p_named_vector()`), without allocation.
+   *
+   * @throws std::range_error if the stage is invalid.
+   * @throws std::invalid_argument if the layout of `values` is not the one of `p_named_vector()`.
+   *
+   * @param[in] stage Stage in [0;N].
+   * @param[out] values NamedVector receiving the values.
+   */
+  void get_parameter_values_as_map(unsigned int stage, NamedVector & values);
+
+// Unchecked API (hot path)
+//
+// The following methods skip all validation (stage range, vector sizes, initialization) and never
+// allocate nor throw. The checks are only performed through `assert()`, i.e., in debug builds.
+// The caller is responsible for providing valid stages and C-arrays of the right size.
+
+  /**
+   * @brief Unchecked version of `set_initial_state_values()`.
+   *
+   * @param x_0 C-array of size nx.
+   */
+  void set_initial_state_values_unchecked(const double * x_0) noexcept;
+
+  /**
+   * @brief Unchecked update of the (differential) state bounds values at a given stage.
+   *
+   * Unlike `set_state_bounds()`, the indexes of the bounded variables are not rewritten.
+   *
+   * @param stage Stage in [0;N].
+   * @param lbx C-array of lower bounds.
+   * @param ubx C-array of upper bounds.
+   */
+  void set_state_bounds_unchecked(unsigned int stage, const double * lbx, const double * ubx) noexcept;
+
+  /**
+   * @brief Unchecked update of the control bounds values at a given stage.
+   *
+   * Unlike `set_control_bounds()`, the indexes of the bounded variables are not rewritten.
+   *
+   * @param stage Stage in [0;N-1].
+   * @param lbu C-array of lower bounds.
+   * @param ubu C-array of upper bounds.
+   */
+  void set_control_bounds_unchecked(unsigned int stage, const double * lbu, const double * ubu) noexcept;
+
+  /**
+   * @brief Unchecked version of `set_runtime_parameters(unsigned int, ValueVector &)`.
+   *
+   * @param stage Stage in [0;N].
+   * @param p_i C-array of size np.
+   */
+  void set_runtime_parameters_unchecked(unsigned int stage, const double * p_i) noexcept;
+
+  /**
+   * @brief Unchecked version of `initialize_state_values(unsigned int, ValueVector &)`.
+   *
+   * @param stage Stage in [0;N].
+   * @param x_i C-array of size nx.
+   */
+  void initialize_state_values_unchecked(unsigned int stage, const double * x_i) noexcept;
+
+  /**
+   * @brief Unchecked version of `initialize_control_values(unsigned int, ValueVector &)`.
+   *
+   * @param stage Stage in [0;N-1].
+   * @param u_i C-array of size nu.
+   */
+  void initialize_control_values_unchecked(unsigned int stage, const double * u_i) noexcept;
+
+  /**
+   * @brief Unchecked version of `get_state_values()` writing into a caller buffer.
+   *
+   * @param stage Stage in [0;N].
+   * @param[out] x_i C-array of size nx.
+   */
+  void get_state_values_unchecked(unsigned int stage, double * x_i) const noexcept;
+
+  /**
+   * @brief Unchecked version of `get_algebraic_state_values()` writing into a caller buffer.
+   *
+   * @param stage Stage in [0;N-1].
+   * @param[out] z_i C-array of size nz.
+   */
+  void get_algebraic_state_values_unchecked(unsigned int stage, double * z_i) const noexcept;
+
+  /**
+   * @brief Unchecked version of `get_control_values()` writing into a caller buffer.
+   *
+   * @param stage Stage in [0;N-1].
+   * @param[out] u_i C-array of size nu.
+   */
+  void get_control_values_unchecked(unsigned int stage, double * u_i) const noexcept;
+
+  /**
+   * @brief Unchecked version of `get_parameter_values()` writing into a caller buffer.
+   *
+   * @param stage Stage in [0;N].
+   * @param[out] p_i C-array of size np.
+   */
+  void get_parameter_values_unchecked(unsigned int stage, double * p_i) const noexcept;
+
+  /**
+   * @brief Unchecked version of `simulate()` (e.g., for sampling-based rollouts).
+   *
+   * @param dt Time step (strictly positive).
+   * @param x0 C-array of size nx.
+   * @param u0 C-array of size nu.
+   * @param p C-array of size np (may be null if np = 0).
+   * @param[out] x_next C-array of size nx.
+   * @param[out] z C-array of size nz (may be null if nz = 0, e.g., the data of an empty buffer).
+   * @return int Internal Acados status (zero if all OK).
+   */
+  int simulate_unchecked(
+    double dt, const double * x0, const double * u0, const double * p, double * x_next,
+    double * z) noexcept;
+
+// Primal-dual iterate
+
+  /**
+   * @brief Allocate an `Iterate` container matching the dimensions of the OCP at each stage.
+   *
+   * @param[out] iterate The container to (re)allocate, values are set to zero.
+   * @return int Status (zero if all OK).
+   */
+  int create_iterate(Iterate & iterate) const;
+
+  /**
+   * @brief Copy the current primal-dual iterate (x, u, z, pi, lam, sl, su) into a preallocated container.
+   *
+   * @param[out] iterate Container allocated by `create_iterate()`.
+   * @return int Status (zero if all OK, non-zero if the stages or dimensions of `iterate` do not match
+   * the OCP, e.g., if it was allocated by a solver with different dimensions).
+   */
+  int get_iterate(Iterate & iterate) const;
+
+  /**
+   * @brief Overwrite the primal-dual iterate (x, u, z, pi, lam, sl, su) of the solver, e.g., to warm-start it.
+   *
+   * @param[in] iterate Container allocated by `create_iterate()`.
+   * @return int Status (zero if all OK, non-zero if the stages or dimensions of `iterate` do not match
+   * the OCP, e.g., if it was allocated by a solver with different dimensions).
+   */
+  int set_iterate(Iterate const & iterate);
+
+// Linear feedback (multi-rate control between solves)
+
+  /**
+   * @brief Compute the sensitivity du_0/dx_0 of the last solution and cache the linear feedback law `u = u_0 + K (x - x_0)`.
+   *
+   * The gain `K` is evaluated column by column with `ocp_nlp_eval_param_sens()` and stored in the buffers allocated by `init()`.
+   * Call it once after each successful `solve()`, then use `evaluate_linear_feedback()` at the (faster) control rate.
+   *
+   * @note The sensitivities are only meaningful if the OCP was exported with an exact Hessian (see Acados documentation).
+   *
+   * @return int Status (zero if all OK).
+   */
+  int update_linear_feedback();
+
+  /**
+   * @brief Evaluate the cached linear feedback law `u = u_0 + K (x - x_0)` (see `update_linear_feedback()`).
+   *
+   * Does not allocate, nor call the Acados solver.
+   *
+   * @param[in] x Current differential state (of size nx).
+   * @param[out] u Control values (of size nu, not resized).
+   * @return int Status (zero if all OK).
+   */
+  int evaluate_linear_feedback(Eigen::Ref<const Eigen::VectorXd> x, Eigen::Ref<Eigen::VectorXd> u) const;
+
+  /**
+   * @brief Evaluate the cached linear feedback law `u = u_0 + K (x - x_0)` (see `update_linear_feedback()`).
+   *
+   * See the other `evaluate_linear_feedback()` method for details.
+   */
+  int evaluate_linear_feedback(ValueVector const & x, ValueVector & u) const;
+
+  /**
+   * @brief Returns the feedback gain K = du_0/dx_0 computed by the last `update_linear_feedback()` call.
+   *
+   * @return const ColumnMajorXd& Matrix of size (nu, nx).
+   */
+  const ColumnMajorXd & linear_feedback_gain() const;
+
 // Getters variable mappings
 
   /**
@@ -567,6 +1051,62 @@ public:
    */
   const IndexMap & u_index_map() const;
 
+  /**
+   * @brief Returns the flat representation of `x_index_map()`, built by `init()`.
+   *
+   * @return const FlatIndexMap&
+   */
+  const FlatIndexMap & x_flat_index_map() const;
+
+  /**
+   * @brief Returns the flat representation of `z_index_map()`, built by `init()`.
+   *
+   * @return const FlatIndexMap&
+   */
+  const FlatIndexMap & z_flat_index_map() const;
+
+  /**
+   * @brief Returns the flat representation of `p_index_map()`, built by `init()`.
+   *
+   * @return const FlatIndexMap&
+   */
+  const FlatIndexMap & p_flat_index_map() const;
+
+  /**
+   * @brief Returns the flat representation of `u_index_map()`, built by `init()`.
+   *
+   * @return const FlatIndexMap&
+   */
+  const FlatIndexMap & u_flat_index_map() const;
+
+  /**
+   * @brief Returns a (zero) NamedVector with the layout of the differential state variables.
+   *
+   * @return NamedVector
+   */
+  NamedVector x_named_vector() const;
+
+  /**
+   * @brief Returns a (zero) NamedVector with the layout of the algebraic state variables.
+   *
+   * @return NamedVector
+   */
+  NamedVector z_named_vector() const;
+
+  /**
+   * @brief Returns a (zero) NamedVector with the layout of the runtime parameters.
+   *
+   * @return NamedVector
+   */
+  NamedVector p_named_vector() const;
+
+  /**
+   * @brief Returns a (zero) NamedVector with the layout of the control variables.
+   *
+   * @return NamedVector
+   */
+  NamedVector u_named_vector() const;
+
 // Values map utils
 
   /**
@@ -733,6 +1273,20 @@ public:
    */
   std::vector<double> sampling_intervals() const;
 
+  /**
+   * @brief Returns the logger used to report failures (e.g., in `solve()`, `simulate()`, or the setters).
+   *
+   * By default, the messages are synchronously written to `std::cerr` / `std::cout`.
+   * For real-time loops, use an `AsyncLogSink` and/or a rate limit, e.g.:
+   * @code
+   * solver.logger().set_sink(std::make_shared<acados::AsyncLogSink>(std::make_shared<acados::StreamLogSink>()));
+   * solver.logger().set_rate_limit(std::chrono::seconds(1));
+   * @endcode
+   *
+   * @return Logger&
+   */
+  Logger & logger();
+
 protected:
   /// @brief Fixed dimensions of the imported Acados OCP.
   Dimensions _dims;
@@ -872,6 +1426,7 @@ protected:
    *
    * This is a wrapper of the `<acados_model_name>_acados_solve(...)` C function.
    * The method returns the internal Acados status.
+   * The parameters and algebraic states may be null if they are empty (np = 0 or nz = 0).
    *
    * @return int (zero if all OK). See Acados documentation for a list of return flags.
    */
@@ -883,6 +1438,24 @@ protected:
     double * x_next /* Differential state next value */,
     double * z_next /* Algebraic state next value */) = 0;
 
+  /**
+   * @brief Simulate the next state and retrieve the forward sensitivities of the sim solver.
+   *
+   * Same as `internal_simulate()`, with `S_forw` the column-major (nx, nx + nu) Jacobian of the next
+   * state w.r.t. (x0, u0). The default implementation returns 13 (not supported), so that plugins
+   * generated with older templates remain valid.
+   *
+   * @return int (zero if all OK). See Acados documentation for a list of return flags.
+   */
+  virtual int internal_simulate_with_sensitivities(
+    double dt /* Time step */,
+    double * x0 /* Differential state initial value */,
+    double * u0 /* Applied controls */,
+    double * p /* Runtime parameters */,
+    double * x_next /* Differential state next value */,
+    double * z_next /* Algebraic state next value */,
+    double * S_forw /* Forward sensitivities, column-major (nx, nx + nu) */);
+
   /**
   * @brief Print the solver stats (e.g., number of SQP iters, number of QP iters, etc.) to the console.
   *
@@ -984,15 +1557,160 @@ public:
   // Private own attributes
 
 private:
+  /**
+   * @brief Cache the C-interface handles (`get_nlp_config()`, `get_nlp_dims()`, etc.) and the horizon length.
+   *
+   * Called by `init()`, the cached pointers remain valid until `free_memory()` is called.
+   * This avoids four virtual calls (that cannot be inlined across the plugin boundary) per setter/getter call.
+   *
+   * @note The `ocp_nlp_solver` handle is not cached since it is re-created by `internal_update_qp_solver_cond_N()`.
+   */
+  void cache_nlp_handles();
+
+  /**
+   * @brief Check that a NamedVector was created with the given layout (e.g., by `x_named_vector()`).
+   *
+   * @param values The NamedVector to be tested.
+   * @param layout The expected layout.
+   * @return true if the layout is the expected one.
+   */
+  bool is_named_vector_consistent(
+    NamedVector const & values,
+    std::shared_ptr<FlatIndexMap> const & layout) const;
+
+  /**
+   * @brief Retrieve the solver statistics from the Acados C-interface and store them in `_solve_stats`.
+   *
+   * @param status The status returned by the last `internal_solve()` call.
+   */
+  void update_solve_stats(int status);
+
+  /**
+   * @brief Predict the initial state over `delay_compensation_latency()` (see `set_delay_compensation()`).
+   *
+   * @param x_0 Measured initial state.
+   * @return ValueVector& The predicted initial state, or `x_0` if the compensation is disabled or failed.
+   */
+  ValueVector & compensate_delay(ValueVector & x_0);
+
+  /**
+   * @brief Check that the stages of an `Iterate` container match the OCP horizon and dimensions.
+   *
+   * Each buffer must have the dimension of its field at its stage (i.e., as allocated by
+   * `create_iterate()`), since the values are read and written in place.
+   *
+   * @param iterate The container to check.
+   * @return true if consistent.
+   */
+  bool is_iterate_consistent(Iterate const & iterate) const;
+
+  /**
+   * @brief Write bounds over a range of stages, skipping unchanged stages if requested.
+   *
+   * The arguments are assumed to be consistent (see `set_state_bounds_trajectory()`).
+   * The last written values are kept in the cache arguments.
+   *
+   * @return int (zero if all OK)
+   */
+  int write_bounds_trajectory(
+    const char * idx_field,
+    const char * lb_field,
+    const char * ub_field,
+    unsigned int first_stage,
+    IndexVector & idx,
+    ColumnMajorXd const & lb_traj,
+    ColumnMajorXd const & ub_traj,
+    bool only_changed,
+    IndexVector & idx_cache,
+    ColumnMajorXd & lb_cache,
+    ColumnMajorXd & ub_cache);
+
   /// @brief Internal flag set to true when `init()` is called.
   bool _is_initialized = false;
 
   /// @brief Sampling time in seconds. If the sampling intervals are variable, then `Ts = -1`.
   double _Ts = -1;
+
+// Cached C-interface handles (see `cache_nlp_handles()`)
+
+  /// @brief Indexes 0, 1, ..., nx-1 used to set the initial state.
+  IndexVector _idxbx_0;
+
+  /// @brief Cached number of shooting nodes.
+  unsigned int _N = 0;
+
+  /// @brief Cached `get_nlp_config()` handle.
+  ocp_nlp_config * _nlp_config = nullptr;
+
+  /// @brief Cached `get_nlp_dims()` handle.
+  ocp_nlp_dims * _nlp_dims = nullptr;
+
+  /// @brief Cached `get_nlp_in()` handle.
+  ocp_nlp_in * _nlp_in = nullptr;
+
+  /// @brief Cached `get_nlp_out()` handle.
+  ocp_nlp_out * _nlp_out = nullptr;
+
+  /// @brief Cached `get_nlp_solver()` handle.
+  ocp_nlp_solver * _nlp_solver = nullptr;
+
+  /// @brief Cached `get_sens_out()` handle.
+  ocp_nlp_out * _sens_out = nullptr;
+
+  /// @brief Cached `get_nlp_opts()` handle.
+  void * _nlp_opts = nullptr;
 // Runtime data
 
+  /// @brief Statistics of the last solve, see `solve_stats()`.
+  SolveStats _solve_stats;
+
+  /// @brief Logger used to report failures, see `logger()`.
+  Logger _logger;
+
+  /// @brief Flat representations of the index maps (used by the map-based setters and getters).
+  std::shared_ptr<FlatIndexMap> _x_flat_index_map, _z_flat_index_map, _p_flat_index_map, _u_flat_index_map;
+
+  /// @brief Preallocated buffers used by the `NamedVector` based setters and getters.
+  ValueVector _x_buffer, _z_buffer, _p_buffer, _u_buffer;
+
+  /// @brief Indexes of each runtime parameter key, built by `init()` for `internal_update_params_sparse()`.
+  std::unordered_map<std::string, std::vector<int>> _p_sparse_indexes;
+
+  /// @brief Preallocated buffer of the forward sensitivities, see `simulate_with_sensitivities()`.
+  ValueVector _S_forw_buffer;
+
+  /// @brief Delay compensation mode, see `set_delay_compensation()`.
+  DelayCompensation _delay_compensation = DelayCompensation::NONE;
+
+  /// @brief Configured latency (in seconds) of the delay compensation.
+  double _delay_compensation_latency = 0.0;
+
+  /// @brief Preallocated buffers used by the delay compensation.
+  ValueVector _delay_x_pred, _delay_z, _delay_p, _delay_u;
+
   /// @brief Internal variable used to store the SQP RTI phase.
   int _rti_phase = 0;
+
+  /// @brief State bounds indexes last written by `set_state_bounds_trajectory()`.
+  IndexVector _idxbx_cache;
+
+  /// @brief State bounds last written by `set_state_bounds_trajectory()` (one column per stage, NaN if unknown).
+  ColumnMajorXd _lbx_cache, _ubx_cache;
+
+  /// @brief Control bounds indexes last written by `set_control_bounds_trajectory()`.
+  IndexVector _idxbu_cache;
+
+  /// @brief Control bounds last written by `set_control_bounds_trajectory()` (one column per stage, NaN if unknown).
+  ColumnMajorXd _lbu_cache, _ubu_cache;
+
+  /// @brief Linear feedback gain du_0/dx_0 of size (nu, nx), see `update_linear_feedback()`.
+  ColumnMajorXd _feedback_gain;
+
+  /// @brief Linearization point (initial state) of the linear feedback law.
+  Eigen::VectorXd _feedback_x0;
+
+  /// @brief Feedforward term (first control) of the linear feedback law.
+  Eigen::VectorXd _feedback_u0;
 };
 
 }  // namespace acados
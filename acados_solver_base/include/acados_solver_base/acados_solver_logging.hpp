@@ -0,0 +1,203 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__ACADOS_SOLVER_LOGGING_HPP_
+#define ACADOS_SOLVER_BASE__ACADOS_SOLVER_LOGGING_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+
+#include "acados_solver_base/lock_free_queue.hpp"
+
+namespace acados
+{
+
+enum class LogLevel
+{
+  DEBUG = 0,     ///< Debug information
+  INFO = 1,      ///< Nominal information
+  WARNING = 2,   ///< Recoverable failure (e.g., solver did not converge)
+  ERROR = 3,     ///< Invalid request or unrecoverable failure
+};
+
+/// @brief Fixed-size log record, so that logging never allocates.
+struct LogRecord
+{
+  /// @brief Maximum length of a message (including the null character), longer messages are truncated.
+  static constexpr size_t MAX_MESSAGE_LENGTH = 256;
+
+  /// @brief Severity of the message
+  LogLevel level = LogLevel::INFO;
+
+  /// @brief Time of the log request (steady clock, in nanoseconds)
+  int64_t stamp_ns = 0;
+
+  /// @brief Null-terminated message
+  char message[MAX_MESSAGE_LENGTH] = {0};
+};
+
+class LogSink
+/**
+* @brief Abstract destination of the log records emitted by an `acados::Logger`.
+*/
+{
+public:
+  virtual ~LogSink() = default;
+
+  /**
+   * @brief Write (or forward) a log record.
+   *
+   * @param record The record to write.
+   */
+  virtual void write(LogRecord const & record) = 0;
+};
+
+class StreamLogSink : public LogSink
+/**
+* @brief Synchronous sink writing to `std::cerr` (warnings and errors) or `std::cout` (other levels).
+*
+* This is the default sink. It is NOT real-time safe since the console output can block.
+*/
+{
+public:
+  void write(LogRecord const & record) override;
+};
+
+class AsyncLogSink : public LogSink
+/**
+* @brief Real-time safe sink: records are pushed to a lock-free queue and written by a background thread.
+*
+* `write()` never blocks nor allocates. If the queue is full, the record is dropped and counted
+* (see `dropped_records()`).
+*/
+{
+public:
+  /**
+   * @brief Constructor of the AsyncLogSink object, starts the background thread.
+   *
+   * @param downstream_sink The (possibly blocking) sink used by the background thread.
+   * @param capacity Maximum number of pending records.
+   * @param polling_period Period at which the background thread drains the queue.
+   */
+  explicit AsyncLogSink(
+    std::shared_ptr<LogSink> downstream_sink,
+    size_t capacity = 128,
+    std::chrono::milliseconds polling_period = std::chrono::milliseconds(10));
+
+  /// @brief Destructor of the AsyncLogSink object, writes the pending records and stops the background thread.
+  ~AsyncLogSink() override;
+
+  void write(LogRecord const & record) override;
+
+  /// @brief Returns the number of records dropped because the queue was full.
+  uint64_t dropped_records() const;
+
+private:
+  /// @brief Write all the pending records to the downstream sink.
+  void drain();
+
+  std::shared_ptr<LogSink> _downstream_sink;
+  LockFreeQueue<LogRecord> _queue;
+  std::chrono::milliseconds _polling_period;
+  std::atomic<bool> _running {true};
+  std::atomic<uint64_t> _dropped_records {0};
+  std::thread _thread;
+};
+
+class Logger
+/**
+* @brief Logger used by `acados::AcadosSolver` to report failures.
+*
+* Messages are formatted (printf-style) into a fixed-size `LogRecord` and forwarded to a pluggable `LogSink`.
+* Optionally, the messages are rate limited per call site (i.e., per format string): within the minimum
+* interval, repeated messages are suppressed and their number is reported with the next emitted one.
+*/
+{
+public:
+  /// @brief Constructor of the Logger object, uses the shared `StreamLogSink` by default.
+  Logger();
+
+  /**
+   * @brief Set the log sink.
+   *
+   * @warning Not thread-safe, must not be called while another thread is logging.
+   *
+   * @param sink The new sink (if nullptr, the messages are discarded).
+   */
+  void set_sink(std::shared_ptr<LogSink> sink);
+
+  /// @brief Returns the current sink.
+  std::shared_ptr<LogSink> sink() const;
+
+  /**
+   * @brief Set the minimum interval between two messages emitted from the same call site.
+   *
+   * @param min_interval Minimum interval, zero (default) disables the rate limiting.
+   */
+  void set_rate_limit(std::chrono::nanoseconds min_interval);
+
+  /**
+   * @brief Set the minimum level of the messages to emit (default: `LogLevel::DEBUG`).
+   *
+   * @param level Minimum level.
+   */
+  void set_level(LogLevel level);
+
+  /**
+   * @brief Format and emit a message.
+   *
+   * Does not allocate. The rate limiting is keyed on the address of `format`.
+   *
+   * @param level Severity of the message.
+   * @param format printf-style format string (should be a string literal).
+   */
+  void log(LogLevel level, const char * format, ...) const
+#if defined(__GNUC__) || defined(__clang__)
+  __attribute__((format(printf, 3, 4)))
+#endif
+  ;
+
+  /**
+   * @brief Returns the process-wide default logger (e.g., used by the static `AcadosSolver` utilities).
+   *
+   * @return Logger&
+   */
+  static Logger & default_logger();
+
+private:
+  /// @brief Number of rate limiting slots (call sites are hashed into these slots).
+  static constexpr size_t RATE_LIMIT_SLOTS = 64;
+
+  struct RateLimitSlot
+  {
+    std::atomic<int64_t> last_emission_ns {std::numeric_limits<int64_t>::min()};
+    std::atomic<uint32_t> suppressed {0};
+  };
+
+  std::shared_ptr<LogSink> _sink;
+  std::atomic<int64_t> _min_interval_ns {0};
+  std::atomic<int> _level {static_cast<int>(LogLevel::DEBUG)};
+  mutable std::array<RateLimitSlot, RATE_LIMIT_SLOTS> _slots;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__ACADOS_SOLVER_LOGGING_HPP_
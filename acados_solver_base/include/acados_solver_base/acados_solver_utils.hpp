@@ -26,6 +26,7 @@
 
 #include "acados_solver_base/acados_solver.hpp"
 #include "acados_solver_base/acados_types.hpp"
+#include "acados_solver_base/trajectory_interpolator.hpp"
 
 
 namespace acados
@@ -265,6 +266,52 @@ int get_stats_sqp_iter(AcadosSolver & solver);
  */
 double get_stats_cpu_time(AcadosSolver & solver);
 
+// ------------------------------------------------------------
+// Warm start
+// ------------------------------------------------------------
+
+/**
+* @brief Re-align the warm start (state and control trajectories) after an arbitrary elapsed time.
+*
+* Instead of shifting the previous solution by exactly one stage, the stored trajectories are resampled
+* at `t_k + elapsed_time` on the (possibly non-uniform) time grid given by `AcadosSolver::sampling_intervals()`
+* (see `acados::TrajectoryInterpolator` for the interpolation scheme). Beyond the horizon, the terminal state
+* and the last control are held. The state and control buffers are thread-local and reused between calls.
+*
+* @throws std::invalid_argument if `elapsed_time` is negative or NaN.
+*
+* @param solver Acados solver C++ wrapper handle
+* @param elapsed_time Time elapsed since the last solve (in seconds, e.g., the actual sampling period).
+* @param interpolator Interpolator used for the resampling (its storage is reused between calls).
+* @return bool Status (true if all OK).
+*/
+bool shift_warm_start(
+  AcadosSolver & solver,
+  double elapsed_time,
+  TrajectoryInterpolator & interpolator);
+
+/**
+* @brief Allocation-free variant of `shift_warm_start()` using an interpolator that is already up to date.
+*
+* The interpolator must have been updated with the current solution of `solver` (see
+* `TrajectoryInterpolator::update()`), e.g., to check the prediction of the plan before shifting it.
+*
+* @throws std::invalid_argument if `elapsed_time` is negative or NaN.
+*
+* @param solver Acados solver C++ wrapper handle
+* @param elapsed_time Time elapsed since the last solve (in seconds, e.g., the actual sampling period).
+* @param interpolator Interpolator holding the current plan of the solver.
+* @param x_buffer Preallocated state buffer (size nx).
+* @param u_buffer Preallocated control buffer (size nu).
+* @return bool Status (true if all OK).
+*/
+bool shift_warm_start(
+  AcadosSolver & solver,
+  double elapsed_time,
+  TrajectoryInterpolator const & interpolator,
+  Eigen::Ref<Eigen::VectorXd> x_buffer,
+  Eigen::Ref<Eigen::VectorXd> u_buffer);
+
 }  // namespace utils
 
 }  // namespace acados
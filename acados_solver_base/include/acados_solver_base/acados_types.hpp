@@ -50,6 +50,13 @@ enum class RtiStage
   FEEDBACK = 1,          ///< RTI feedback stage
 };
 
+enum class DelayCompensation
+{
+  NONE = 0,          ///< The initial state is used as is
+  CONFIGURED = 1,    ///< The initial state is predicted over a configured latency
+  MEASURED = 2,      ///< The initial state is predicted over the duration of the last solve
+};
+
 }  // namespace acados
 
 #endif  // ACADOS_SOLVER_BASE__ACADOS_TYPES_HPP_
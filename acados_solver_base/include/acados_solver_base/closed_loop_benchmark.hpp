@@ -0,0 +1,174 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__CLOSED_LOOP_BENCHMARK_HPP_
+#define ACADOS_SOLVER_BASE__CLOSED_LOOP_BENCHMARK_HPP_
+
+#include <Eigen/Dense>
+
+#include <ostream>
+#include <vector>
+
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_solver_base/acados_types.hpp"
+
+namespace acados
+{
+
+class ClosedLoopBenchmark
+/**
+* @brief Closed-loop simulation benchmark of an `AcadosSolver`, using its embedded sim solver as plant.
+*
+* At each step, the current state is set as initial state, the OCP is solved (or the feedback phase
+* of the RTI scheme, in which case the preparation phase is run after the control is applied), and
+* the plant is simulated over `Ts()` with the control of the first stage.
+*
+* Each step records the wall-clock solve time, the solver statistics, whether the deadline was
+* missed, and the stage tracking cost
+* \f$ \sum_i w_{x,i} (x_i - x_{ref,i})^2 + \sum_j w_{u,j} u_j^2 \f$.
+* The results can be exported as CSV (one row per step) or JSON (summary and per-step arrays).
+*
+* Typical usage:
+* @code
+* ClosedLoopBenchmark::Options options;
+* options.num_steps = 500;
+* options.x0 = {{"p", {0.0}}, {"p_dot", {0.0}}, {"theta", {0.1}}, {"theta_dot", {0.0}}};
+* options.x_ref = {{"theta", {0.0}}};
+* ClosedLoopBenchmark benchmark(solver, options);
+* benchmark.run();
+* benchmark.write_json(std::cout);
+* @endcode
+*/
+{
+public:
+  class Options
+  {
+public:
+    /// @brief Number of closed-loop steps.
+    unsigned int num_steps = 100;
+
+    /// @brief Initial state of the plant (all keys of `x_index_map()`).
+    ValueMap x0;
+
+    /// @brief Runtime parameters of the solver and of the plant (all keys of `p_index_map()`, if np > 0).
+    ValueMap p;
+
+    /// @brief State reference (zero for the state variables without entry).
+    ValueMap x_ref;
+
+    /// @brief Tracking weights of the state variables (default: one for the keys of `x_ref`, else zero).
+    ValueMap x_weights;
+
+    /// @brief Weights of the control effort (zero for the control variables without entry).
+    ValueMap u_weights;
+
+    /// @brief Deadline of each solve, in seconds (zero to use `Ts()`).
+    double deadline = 0.0;
+
+    /// @brief Use the RTI scheme instead of `solve()` (only the feedback phase is timed).
+    bool use_rti = false;
+  };
+
+  /// @brief Record of a closed-loop step.
+  class StepRecord
+  {
+public:
+    double time = 0.0;
+    int status = 0;
+    /// @brief Wall-clock time of the (feedback) solve, in seconds.
+    double solve_time = 0.0;
+    /// @brief CPU time reported by acados, in seconds.
+    double time_tot = 0.0;
+    int sqp_iter = 0;
+    int qp_iter = 0;
+    bool deadline_missed = false;
+    double stage_cost = 0.0;
+    /// @brief Plant state at the beginning of the step and applied control.
+    ValueVector x, u;
+  };
+
+  /// @brief Summary of a closed-loop run.
+  class Summary
+  {
+public:
+    size_t num_steps = 0;
+    size_t num_failures = 0;
+    size_t num_deadline_misses = 0;
+    double solve_time_min = 0.0;
+    double solve_time_mean = 0.0;
+    double solve_time_p50 = 0.0;
+    double solve_time_p95 = 0.0;
+    double solve_time_p99 = 0.0;
+    double solve_time_max = 0.0;
+    double sqp_iter_mean = 0.0;
+    int sqp_iter_max = 0;
+    /// @brief Sum of the stage costs.
+    double tracking_cost = 0.0;
+  };
+
+  /**
+   * @brief Constructor of the ClosedLoopBenchmark object.
+   *
+   * @throws std::invalid_argument if the solver is not initialized or if the options are invalid.
+   *
+   * @param solver Initialized solver (must outlive this object).
+   * @param options Benchmark options.
+   */
+  ClosedLoopBenchmark(AcadosSolver & solver, Options const & options);
+
+  /**
+   * @brief Run the closed-loop simulation (the records of a previous run are discarded).
+   *
+   * A failed solve is recorded and the control it returns is applied anyway.
+   *
+   * @return int Zero if all OK, else the status of the failed plant simulation (the run is aborted).
+   */
+  int run();
+
+  /// @brief Returns the records of the last run.
+  const std::vector<StepRecord> & records() const;
+
+  /// @brief Returns the summary of the last run.
+  const Summary & summary() const;
+
+  /// @brief Write the records as CSV (header, then one row per step).
+  void write_csv(std::ostream & stream) const;
+
+  /// @brief Write the summary, the runtime parameters, and the records (as per-step arrays) as JSON.
+  void write_json(std::ostream & stream) const;
+
+private:
+  /// @brief Compute the summary from the records.
+  void compute_summary();
+
+  AcadosSolver & _solver;
+  unsigned int _num_steps;
+  double _deadline;
+  bool _use_rti;
+
+  /// @brief Initial state (size nx) and runtime parameters (size np).
+  ValueVector _x0, _p;
+
+  /// @brief Tracking reference and weights (sizes nx and nu).
+  Eigen::VectorXd _x_ref, _x_weights, _u_weights;
+
+  std::vector<StepRecord> _records;
+  Summary _summary;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__CLOSED_LOOP_BENCHMARK_HPP_
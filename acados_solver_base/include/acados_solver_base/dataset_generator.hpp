@@ -0,0 +1,222 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__DATASET_GENERATOR_HPP_
+#define ACADOS_SOLVER_BASE__DATASET_GENERATOR_HPP_
+
+#include <Eigen/Dense>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_solver_base/acados_types.hpp"
+
+namespace acados
+{
+
+/**
+* @brief Columnar binary dataset format written by `DatasetGenerator` (little-endian, memory-mappable).
+*
+* The file starts with a `DatasetFileHeader`, followed by `num_columns` `DatasetColumnHeader`.
+* Each column is then stored contiguously as a row-major float64 array of shape (num_samples, width),
+* starting at `offset` (aligned on `DATASET_ALIGNMENT` bytes).
+*
+* From Python, a column can be mapped without copy with, e.g.,
+* `np.memmap(path, dtype='<f8', mode='r', offset=offset, shape=(num_samples, width))`.
+*/
+constexpr char DATASET_MAGIC[8] = {'A', 'C', 'A', 'D', 'O', 'S', 'D', 'S'};
+constexpr uint32_t DATASET_VERSION = 1;
+constexpr uint64_t DATASET_ALIGNMENT = 64;
+
+struct DatasetFileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t num_columns;
+  uint64_t num_samples;
+};
+
+struct DatasetColumnHeader
+{
+  /// @brief Null-terminated column name.
+  char name[48];
+  /// @brief Offset of the column data from the beginning of the file (in bytes).
+  uint64_t offset;
+  /// @brief Number of values per sample.
+  uint64_t width;
+};
+
+class DatasetGenerator
+/**
+* @brief Offline generation of OCP solutions datasets (e.g., to train learned MPC approximations).
+*
+* The initial states and runtime parameters are sampled uniformly over the user-given ranges (by key).
+* The state variables without range are fixed to zero, and the parameters without range are fixed to
+* the values of the first solver returned by the factory (stage 0). The samples are then solved in parallel, each
+* worker thread owning an independent solver instance created by the factory, and processing a
+* contiguous chunk of samples so that each solve is warm-started by the previous solution.
+*
+* The results are written directly into the memory-mapped output file (see `DatasetFileHeader`), with
+* the columns "x0" (nx), "p" (np, if np > 0), "status", "solve_time", "sqp_iter", "u0" (nu), and,
+* if `store_trajectories` is set, "x_traj" ((N+1) * nx) and "u_traj" (N * nu).
+*
+* Typical usage:
+* @code
+* DatasetGenerator::Options options;
+* options.num_samples = 1000000;
+* options.x0_lower = {{"theta", {-0.5}}};
+* options.x0_upper = {{"theta", {0.5}}};
+* DatasetGenerator generator(
+*   [&]() {auto solver = loader.createSharedInstance(name); solver->init(N, Ts); return solver;},
+*   options);
+* generator.generate("/tmp/dataset.bin");
+* @endcode
+*/
+{
+public:
+  /// @brief Factory of initialized solver instances (called once per worker thread).
+  using SolverFactory = std::function<std::shared_ptr<AcadosSolver>()>;
+
+  class Options
+  {
+public:
+    size_t num_samples = 1000;
+
+    /// @brief Number of worker threads (zero for `std::thread::hardware_concurrency()`).
+    unsigned int num_threads = 0;
+
+    /// @brief Seed of the random number generator (the samples do not depend on `num_threads`).
+    uint64_t seed = 0;
+
+    /// @brief Sampling ranges of the initial state (same keys in both maps).
+    ValueMap x0_lower, x0_upper;
+
+    /// @brief Sampling ranges of the runtime parameters (same keys in both maps, missing keys are
+    /// fixed to the values set by the factory).
+    ValueMap p_lower, p_upper;
+
+    /// @brief Warm-start each solve with the previous solution of the worker (else `reset()` first).
+    bool warm_start = true;
+
+    /// @brief Store the full state and control trajectories (else only the first control).
+    bool store_trajectories = false;
+  };
+
+  class Summary
+  {
+public:
+    size_t num_samples = 0;
+    size_t num_failures = 0;
+    /// @brief Wall-clock duration of the generation, in seconds.
+    double elapsed_time = 0.0;
+  };
+
+  /**
+   * @brief Constructor of the DatasetGenerator object.
+   *
+   * A first solver instance is created to validate the options (it is then used by the first worker).
+   *
+   * @throws std::invalid_argument if the factory returns an uninitialized solver or if the ranges are
+   * invalid.
+   *
+   * @param solver_factory Factory of initialized solver instances (thread-safe calls not required).
+   * @param options Generation options.
+   */
+  DatasetGenerator(SolverFactory solver_factory, Options const & options);
+
+  /**
+   * @brief Sample, solve, and write the dataset.
+   *
+   * @throws std::runtime_error if the output file cannot be created or mapped.
+   *
+   * @param path Output file (overwritten).
+   * @return Summary Generation summary.
+   */
+  Summary generate(std::string const & path);
+
+private:
+  /// @brief Solve the samples [begin, end) and write the results.
+  void solve_chunk(AcadosSolver & solver, size_t begin, size_t end, size_t & num_failures);
+
+  SolverFactory _solver_factory;
+  Options _options;
+  std::shared_ptr<AcadosSolver> _first_solver;
+  unsigned int _nx, _nu, _np, _N;
+
+  /// @brief Dense sampling ranges (sizes nx and np).
+  Eigen::VectorXd _x0_lower, _x0_upper, _p_lower, _p_upper;
+
+  /// @brief Column pointers into the mapped file (valid during `generate()`).
+  double * _x0_data = nullptr, * _p_data = nullptr, * _status_data = nullptr;
+  double * _solve_time_data = nullptr, * _sqp_iter_data = nullptr, * _u0_data = nullptr;
+  double * _x_traj_data = nullptr, * _u_traj_data = nullptr;
+};
+
+class DatasetReader
+/**
+* @brief Read-only memory mapping of a dataset written by `DatasetGenerator`.
+*
+* The columns are exposed as row-major matrices of shape (num_samples, width), without copy.
+*/
+{
+public:
+  using ColumnMap = Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic,
+      Eigen::RowMajor>>;
+
+  /**
+   * @brief Map a dataset file.
+   *
+   * @throws std::runtime_error if the file cannot be mapped or is not a valid dataset.
+   *
+   * @param path Dataset file.
+   */
+  explicit DatasetReader(std::string const & path);
+
+  ~DatasetReader();
+
+  DatasetReader(DatasetReader const &) = delete;
+  DatasetReader & operator=(DatasetReader const &) = delete;
+
+  /// @brief Returns the number of samples.
+  size_t num_samples() const;
+
+  /// @brief Returns the names of the columns.
+  std::vector<std::string> column_names() const;
+
+  /// @brief Returns true if the dataset has the column.
+  bool has_column(std::string const & name) const;
+
+  /**
+   * @brief Returns a view of a column (shape (num_samples, width)).
+   *
+   * @throws std::invalid_argument if the column does not exist.
+   */
+  ColumnMap column(std::string const & name) const;
+
+private:
+  void * _address = nullptr;
+  size_t _size = 0;
+  DatasetFileHeader const * _header = nullptr;
+  DatasetColumnHeader const * _columns = nullptr;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__DATASET_GENERATOR_HPP_
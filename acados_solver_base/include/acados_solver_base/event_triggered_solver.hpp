@@ -0,0 +1,141 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__EVENT_TRIGGERED_SOLVER_HPP_
+#define ACADOS_SOLVER_BASE__EVENT_TRIGGERED_SOLVER_HPP_
+
+#include <Eigen/Dense>
+
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_solver_base/acados_types.hpp"
+#include "acados_solver_base/trajectory_interpolator.hpp"
+
+namespace acados
+{
+
+class EventTriggeredSolver
+/**
+* @brief Event-triggering layer over `AcadosSolver::solve()`.
+*
+* At each tick, the measured initial state is compared to the state predicted by the current plan
+* (i.e., stage 1 for a nominal tick). If every state variable stays within its threshold, the plan is
+* shifted (see `utils::shift_warm_start()`) instead of solving the OCP again.
+* Otherwise, the initial state is set and the OCP is solved as usual.
+*
+* A solve is always triggered if no successful solution is available yet, after `max_skipped_solves`
+* consecutive skips, or after a call to `force_next_solve()` (e.g., when the runtime parameters changed).
+*
+* Typical usage:
+* @code
+* int status = event_triggered_solver.solve(x0);
+* solver.get_control_values(0);  // Valid in both cases (new or shifted plan)
+* @endcode
+*/
+{
+public:
+  class Options
+  {
+public:
+    /**
+     * @brief Absolute thresholds on the prediction error of the initial state, keyed as in `x_index_map()`.
+     *
+     * Each entry must have the same size as the corresponding entry of `x_index_map()`.
+     * The state variables without entry use `default_threshold`.
+     */
+    ValueMap x0_thresholds;
+
+    /// @brief Threshold of the state variables without entry in `x0_thresholds` (zero to always solve).
+    double default_threshold = 0.0;
+
+    /// @brief Maximum number of consecutive skipped solves (zero to never skip).
+    unsigned int max_skipped_solves = 5;
+  };
+
+  /**
+   * @brief Constructor of the EventTriggeredSolver object.
+   *
+   * @throws std::invalid_argument if the solver is not initialized or if the thresholds are invalid.
+   *
+   * @param solver Initialized solver (must outlive this object).
+   * @param options Event-triggering options.
+   */
+  EventTriggeredSolver(AcadosSolver & solver, Options const & options);
+
+  /**
+   * @brief Solve the OCP, or shift the current plan by one stage if the prediction is accurate enough.
+   *
+   * @param x0 Measured initial state (size nx).
+   * @return int Acados status of the solve (status of the last solve if skipped).
+   */
+  int solve(ValueVector & x0);
+
+  /**
+   * @brief Same as `solve()`, but the prediction is evaluated at (and the plan shifted by) the actual
+   * time elapsed since the last tick.
+   *
+   * @param x0 Measured initial state (size nx).
+   * @param elapsed_time Time elapsed since the last tick (in seconds).
+   * @return int Acados status of the solve (status of the last solve if skipped).
+   */
+  int solve(ValueVector & x0, double elapsed_time);
+
+  /// @brief Trigger a solve at the next tick, whatever the prediction error.
+  void force_next_solve();
+
+  /// @brief Returns true if the last tick reused the shifted plan instead of solving.
+  bool last_solve_skipped() const;
+
+  /// @brief Returns the number of solves triggered since construction.
+  size_t num_solves() const;
+
+  /// @brief Returns the number of skipped solves since construction.
+  size_t num_skipped_solves() const;
+
+  /// @brief Returns the prediction error of the initial state computed at the last tick (size nx).
+  const Eigen::VectorXd & prediction_error() const;
+
+private:
+  /// @brief Returns true if the measured initial state is close enough to the prediction.
+  bool is_prediction_accurate(ValueVector const & x0, double elapsed_time);
+
+  AcadosSolver & _solver;
+
+  /// @brief Thresholds of all state variables (size nx).
+  Eigen::VectorXd _thresholds;
+
+  unsigned int _max_skipped_solves;
+
+  TrajectoryInterpolator _interpolator;
+
+  /// @brief Predicted initial state and prediction error (size nx).
+  Eigen::VectorXd _x0_prediction, _prediction_error;
+
+  /// @brief Preallocated buffers of the shifted plan (size nx and nu).
+  Eigen::VectorXd _x_buffer, _u_buffer;
+
+  /// @brief First sampling interval of the solver (default elapsed time).
+  double _first_sampling_interval;
+
+  bool _force_solve = true;
+  bool _last_solve_skipped = false;
+  unsigned int _consecutive_skips = 0;
+  size_t _num_solves = 0;
+  size_t _num_skipped_solves = 0;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__EVENT_TRIGGERED_SOLVER_HPP_
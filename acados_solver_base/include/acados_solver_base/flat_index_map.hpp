@@ -0,0 +1,166 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__FLAT_INDEX_MAP_HPP_
+#define ACADOS_SOLVER_BASE__FLAT_INDEX_MAP_HPP_
+
+#include <string>
+#include <vector>
+
+#include "acados_solver_base/acados_types.hpp"
+
+namespace acados
+{
+
+class FlatIndexMap
+/**
+* @brief Flat (structure of arrays) representation of an `acados::IndexMap`.
+*
+* The keys are sorted and the indexes of all keys are stored in a single contiguous array.
+* When the indexes of a key form a contiguous range (e.g., `{"q", {0, 1}}`, the common case),
+* the values are copied with a single `memcpy()` instead of an element-wise gather/scatter.
+*
+* The `IndexMap` remains the reference description of the variables (see `AcadosSolver::x_index_map()`),
+* this class is built once from it (see `AcadosSolver::init()`).
+*/
+{
+public:
+  /// @brief Value returned by `find()` if the key is not found.
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  FlatIndexMap() = default;
+
+  /**
+   * @brief Constructor of the FlatIndexMap object.
+   *
+   * @param index_map Mapping between keys and indexes.
+   */
+  explicit FlatIndexMap(IndexMap const & index_map);
+
+  /**
+   * @brief (Re)build the flat representation from an index map.
+   *
+   * @param index_map Mapping between keys and indexes.
+   */
+  void assign(IndexMap const & index_map);
+
+  /// @brief Returns the number of keys.
+  size_t num_keys() const;
+
+  /// @brief Returns the total number of indexes (i.e., the size of the value vector).
+  size_t total_size() const;
+
+  /**
+   * @brief Returns the position of a key (in [0, num_keys()[) or `FlatIndexMap::npos` if not found.
+   *
+   * @param key Name of the variable.
+   * @return size_t
+   */
+  size_t find(std::string const & key) const;
+
+  /// @brief Returns the name of the i-th key (sorted alphabetically).
+  const std::string & key(size_t key_id) const;
+
+  /// @brief Returns the number of indexes of the i-th key.
+  size_t size(size_t key_id) const;
+
+  /// @brief Returns a pointer to the indexes of the i-th key (see `size()` for their number).
+  const unsigned int * indexes(size_t key_id) const;
+
+  /// @brief Returns true if the indexes of the i-th key form a contiguous range.
+  bool is_contiguous(size_t key_id) const;
+
+  /**
+   * @brief Returns the position of the first value of the i-th key in the packed representation.
+   *
+   * In the packed representation, the values are grouped by key (sorted alphabetically), see `pack()`.
+   *
+   * @param key_id Position of the key (see `find()`).
+   * @return size_t
+   */
+  size_t offset(size_t key_id) const;
+
+  /**
+   * @brief Copy the values of the i-th key from the full value vector.
+   *
+   * @param[in] key_id Position of the key (see `find()`).
+   * @param[in] values Full value vector (size `max index + 1`).
+   * @param[out] key_values Values of the key (size `size(key_id)`).
+   */
+  void gather(size_t key_id, const double * values, double * key_values) const;
+
+  /**
+   * @brief Copy the values of the i-th key into the full value vector.
+   *
+   * @param[in] key_id Position of the key (see `find()`).
+   * @param[in] key_values Values of the key (size `size(key_id)`).
+   * @param[out] values Full value vector (size `max index + 1`).
+   */
+  void scatter(size_t key_id, const double * key_values, double * values) const;
+
+  /**
+   * @brief Fill a value vector with the values contained in the value map.
+   *
+   * @warning The value map must be complete (see `AcadosSolver::is_values_map_complete()`).
+   *
+   * @param[in] values_map Mapping between keys and values.
+   * @param[out] values Full value vector (size `total_size()`).
+   */
+  void fill_vector_from_map(ValueMap const & values_map, double * values) const;
+
+  /**
+   * @brief Fill a ValueMap object with the values of the value vector.
+   *
+   * The existing entries of `value_map` are reused (i.e., no allocation once the map is populated).
+   *
+   * @param[in] values Full value vector (size `total_size()`).
+   * @param[out] value_map The ValueMap object to be filled with the values.
+   */
+  void fill_map_from_values(const double * values, ValueMap & value_map) const;
+
+  /**
+   * @brief Copy the full value vector into its packed representation (values grouped by key).
+   *
+   * @param[in] values Full value vector (size `total_size()`).
+   * @param[out] packed_values Packed values (size `total_size()`).
+   */
+  void pack(const double * values, double * packed_values) const;
+
+  /**
+   * @brief Copy packed values (grouped by key) into the full value vector.
+   *
+   * @param[in] packed_values Packed values (size `total_size()`).
+   * @param[out] values Full value vector (size `total_size()`).
+   */
+  void unpack(const double * packed_values, double * values) const;
+
+private:
+  /// @brief Sorted keys.
+  std::vector<std::string> _keys;
+
+  /// @brief Offsets of the indexes of each key in `_indexes` (size `num_keys() + 1`).
+  std::vector<size_t> _offsets;
+
+  /// @brief Indexes of all keys, stored contiguously.
+  std::vector<unsigned int> _indexes;
+
+  /// @brief True if the indexes of the corresponding key form a contiguous range.
+  std::vector<bool> _is_contiguous;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__FLAT_INDEX_MAP_HPP_
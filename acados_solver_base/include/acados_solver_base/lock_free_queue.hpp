@@ -0,0 +1,140 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__LOCK_FREE_QUEUE_HPP_
+#define ACADOS_SOLVER_BASE__LOCK_FREE_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace acados
+{
+
+template<typename T>
+class LockFreeQueue
+/**
+* @brief Bounded multi-producer/multi-consumer lock-free queue (D. Vyukov's algorithm).
+*
+* The storage is allocated once by the constructor, `try_push()` and `try_pop()` never allocate nor block.
+* `T` must be default constructible and copy assignable.
+*/
+{
+public:
+  /**
+   * @brief Constructor of the LockFreeQueue object.
+   *
+   * @param capacity Maximum number of elements, rounded up to the next power of two (at least 2).
+   */
+  explicit LockFreeQueue(size_t capacity)
+  {
+    size_t rounded_capacity = 2;
+    while (rounded_capacity < capacity) {
+      rounded_capacity *= 2;
+    }
+    _mask = rounded_capacity - 1;
+    _cells.reset(new Cell[rounded_capacity]);
+    for (size_t i = 0; i < rounded_capacity; i++) {
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _enqueue_pos.store(0, std::memory_order_relaxed);
+    _dequeue_pos.store(0, std::memory_order_relaxed);
+  }
+
+  LockFreeQueue(const LockFreeQueue &) = delete;
+  LockFreeQueue & operator=(const LockFreeQueue &) = delete;
+
+  /**
+   * @brief Push an element if the queue is not full.
+   *
+   * @param value The element to copy into the queue.
+   * @return true if the element was pushed, false if the queue is full.
+   */
+  bool try_push(const T & value) noexcept
+  {
+    Cell * cell = nullptr;
+    size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    for (;; ) {
+      cell = &_cells[pos & _mask];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // Full
+      } else {
+        pos = _enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Pop an element if the queue is not empty.
+   *
+   * @param[out] value The popped element.
+   * @return true if an element was popped, false if the queue is empty.
+   */
+  bool try_pop(T & value) noexcept
+  {
+    Cell * cell = nullptr;
+    size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+    for (;; ) {
+      cell = &_cells[pos & _mask];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // Empty
+      } else {
+        pos = _dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    value = cell->value;
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief Returns the (rounded) capacity of the queue.
+  size_t capacity() const
+  {
+    return _mask + 1;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> _cells;
+  size_t _mask = 0;
+  alignas(64) std::atomic<size_t> _enqueue_pos;
+  alignas(64) std::atomic<size_t> _dequeue_pos;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__LOCK_FREE_QUEUE_HPP_
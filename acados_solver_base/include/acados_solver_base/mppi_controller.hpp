@@ -0,0 +1,227 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__MPPI_CONTROLLER_HPP_
+#define ACADOS_SOLVER_BASE__MPPI_CONTROLLER_HPP_
+
+#include <Eigen/Dense>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_solver_base/acados_types.hpp"
+
+namespace acados
+{
+
+class MppiController
+/**
+* @brief Model Predictive Path Integral (MPPI) controller using the sim solver embedded in the plugins.
+*
+* At each call to `solve()`, `num_samples` perturbed control sequences (Gaussian noise around the
+* nominal sequence, clamped to the control limits) are rolled out over the horizon of the solver, in
+* parallel: each worker thread owns an independent solver instance (i.e., its own sim capsule) created
+* by the factory, and only uses its `simulate_unchecked()`. The first sample is the nominal sequence.
+*
+* The stage costs \f$ \sum_i w_{x,i} (x_i - x_{ref,i})^2 + \sum_j w_{u,j} u_j^2 \f$ are accumulated
+* stage by stage over all the rollouts of a worker at once (column-wise Eigen array expressions).
+* The nominal sequence is then updated as the average of the sampled sequences weighted by
+* \f$ \exp(-(S - S_{min}) / \lambda) \f$, and the nominal state trajectory is rolled out.
+*
+* The result can be used directly (`control_trajectory()`) or to warm-start an `AcadosSolver` with
+* the same horizon (`warm_start()`), e.g., for highly non-convex tasks where SQP struggles.
+*
+* Typical usage:
+* @code
+* MppiController mppi(solver_factory, options);
+* mppi.set_runtime_parameters(p);
+* mppi.solve(x0);
+* mppi.warm_start(solver);
+* solver.set_initial_state_values(x0);
+* solver.solve();
+* mppi.shift();  // Next control period
+* @endcode
+*/
+{
+public:
+  /// @brief Factory of initialized solver instances (called once per worker thread, at construction).
+  using SolverFactory = std::function<std::shared_ptr<AcadosSolver>()>;
+
+  class Options
+  {
+public:
+    /// @brief Number of sampled control sequences per solve.
+    unsigned int num_samples = 1024;
+
+    /// @brief Number of worker threads (zero for `std::thread::hardware_concurrency()`).
+    unsigned int num_threads = 0;
+
+    /// @brief Temperature of the path-integral weights.
+    double lambda = 1.0;
+
+    /// @brief Standard deviation of the control noise, keyed as in `u_index_map()`.
+    ValueMap noise_std;
+
+    /// @brief Standard deviation of the control variables without entry in `noise_std`.
+    double default_noise_std = 1.0;
+
+    /// @brief Control limits (unbounded for the control variables without entry).
+    ValueMap u_lower, u_upper;
+
+    /// @brief State reference (zero for the state variables without entry).
+    ValueMap x_ref;
+
+    /// @brief Tracking weights of the state variables (default: one for the keys of `x_ref`, else zero).
+    ValueMap x_weights;
+
+    /// @brief Weights of the control effort (zero for the control variables without entry).
+    ValueMap u_weights;
+
+    /// @brief Factor applied to the state cost of the terminal stage.
+    double terminal_weight = 1.0;
+
+    /// @brief Seed of the random number generators.
+    uint64_t seed = 0;
+  };
+
+  /**
+   * @brief Constructor of the MppiController object (the worker threads are started here).
+   *
+   * @throws std::invalid_argument if the factory returns an uninitialized solver or if the options
+   * are invalid.
+   *
+   * @param solver_factory Factory of initialized solver instances (same dimensions and horizon).
+   * @param options MPPI options.
+   */
+  MppiController(SolverFactory solver_factory, Options const & options);
+
+  ~MppiController();
+
+  MppiController(MppiController const &) = delete;
+  MppiController & operator=(MppiController const &) = delete;
+
+  /**
+   * @brief Set the runtime parameters used by the rollouts (all stages).
+   *
+   * @throws std::invalid_argument if the size of `p` does not match np.
+   */
+  void set_runtime_parameters(ValueVector const & p);
+
+  /**
+   * @brief Sample, roll out, and update the nominal control sequence.
+   *
+   * The rollouts whose simulation failed are discarded.
+   *
+   * @throws std::invalid_argument if the size of `x0` does not match nx.
+   *
+   * @param x0 Initial state (size nx).
+   * @return int Zero if all OK, else the status of a failed simulation (or `ACADOS_NAN_DETECTED`) if
+   * all the rollouts failed (the nominal sequence is then left unchanged).
+   */
+  int solve(ValueVector const & x0);
+
+  /// @brief Shift the nominal control sequence by one stage (the last control is repeated).
+  void shift();
+
+  /// @brief Reset the nominal control sequence to zero (clamped to the control limits).
+  void reset();
+
+  /// @brief Returns the nominal control sequence (nu x N).
+  const Eigen::MatrixXd & control_trajectory() const;
+
+  /// @brief Returns the nominal state trajectory of the last solve (nx x (N+1)).
+  const Eigen::MatrixXd & state_trajectory() const;
+
+  /// @brief Returns the minimum rollout cost of the last solve.
+  double min_cost() const;
+
+  /// @brief Returns the effective sample size of the last solve, in [1, num_samples].
+  double effective_sample_size() const;
+
+  /// @brief Returns the number of worker threads.
+  unsigned int num_threads() const;
+
+  /**
+   * @brief Initialize the primal iterate of a solver with the nominal trajectories.
+   *
+   * @throws std::invalid_argument if the dimensions or the horizon of the solver do not match.
+   */
+  void warm_start(AcadosSolver & solver) const;
+
+private:
+  struct Worker
+  {
+    std::shared_ptr<AcadosSolver> solver;
+    std::thread thread;
+    std::mt19937_64 generator;
+    /// @brief Samples [begin, end) processed by the worker.
+    size_t begin = 0, end = 0;
+    /// @brief States of the rollouts of the worker (nx x (end - begin)).
+    Eigen::MatrixXd x;
+    Eigen::VectorXd x_next, z;
+    int status = 0;
+  };
+
+  /// @brief Loop of the worker threads (one rollout batch per generation).
+  void worker_loop(Worker & worker);
+
+  /// @brief Sample and roll out the sequences [worker.begin, worker.end).
+  void rollout(Worker & worker);
+
+  /// @brief Clamp the controls of a sequence (stacked stages, size nu * N) to the control limits.
+  void clamp(Eigen::Ref<Eigen::VectorXd> sequence) const;
+
+  unsigned int _nx, _nu, _np, _N, _num_samples;
+  double _lambda, _terminal_weight;
+  std::vector<double> _sampling_intervals;
+
+  /// @brief Noise standard deviation and control limits (size nu * N, stacked stages).
+  Eigen::VectorXd _noise_std, _u_lower, _u_upper;
+
+  /// @brief Cost weights and reference.
+  Eigen::VectorXd _x_ref, _x_weights, _u_weights;
+
+  /// @brief Rollout inputs and outputs.
+  Eigen::VectorXd _x0, _p, _costs, _weights;
+
+  /// @brief Nominal control sequence (size nu * N) and sampled sequences (nu * N x num_samples).
+  Eigen::VectorXd _u_nominal;
+  Eigen::MatrixXd _u_samples;
+
+  /// @brief Nominal trajectories (views of the last solve).
+  Eigen::MatrixXd _u_trajectory, _x_trajectory;
+  double _min_cost = 0.0;
+  double _effective_sample_size = 0.0;
+
+  // Worker pool
+  std::vector<Worker> _workers;
+  std::mutex _mutex;
+  std::condition_variable _start_cv, _done_cv;
+  uint64_t _generation = 0;
+  unsigned int _num_pending = 0;
+  bool _stop_requested = false;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__MPPI_CONTROLLER_HPP_
@@ -0,0 +1,138 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__NAMED_VECTOR_HPP_
+#define ACADOS_SOLVER_BASE__NAMED_VECTOR_HPP_
+
+#include <Eigen/Dense>
+
+#include <memory>
+#include <string>
+
+#include "acados_solver_base/acados_types.hpp"
+#include "acados_solver_base/flat_index_map.hpp"
+
+namespace acados
+{
+
+class NamedVector
+/**
+* @brief Named values stored in a single contiguous buffer, alternative to `acados::ValueMap`.
+*
+* The name layout is shared and immutable (e.g., `AcadosSolver::x_named_vector()` uses the layout of
+* `AcadosSolver::x_flat_index_map()`). The values are grouped by key (see `FlatIndexMap::pack()`),
+* so that each key can be accessed through a map-like view without any allocation:
+* @code
+* acados::NamedVector x = solver.x_named_vector();  // allocates once
+* solver.get_state_values_as_map(stage, x);          // no allocation
+* double theta = x["theta"][0];
+* @endcode
+*/
+{
+public:
+  /// @brief Mutable view of the values of a key.
+  using View = Eigen::Map<Eigen::VectorXd>;
+
+  /// @brief Constant view of the values of a key.
+  using ConstView = Eigen::Map<const Eigen::VectorXd>;
+
+  NamedVector() = default;
+
+  /**
+   * @brief Constructor of the NamedVector object, all values are set to zero.
+   *
+   * @param layout Shared name layout.
+   */
+  explicit NamedVector(std::shared_ptr<const FlatIndexMap> layout);
+
+  /**
+   * @brief Constructor of the NamedVector object from a value map.
+   *
+   * @throws std::invalid_argument if the value map is not complete.
+   *
+   * @param layout Shared name layout.
+   * @param values_map Mapping between keys and values.
+   */
+  NamedVector(std::shared_ptr<const FlatIndexMap> layout, ValueMap const & values_map);
+
+  /// @brief Returns the shared name layout.
+  const std::shared_ptr<const FlatIndexMap> & layout() const;
+
+  /// @brief Returns the total number of values.
+  size_t size() const;
+
+  /// @brief Returns true if the layout contains the key.
+  bool contains(std::string const & key) const;
+
+  /**
+   * @brief Returns a view of the values of a key.
+   *
+   * @throws std::out_of_range if the key is not found.
+   *
+   * @param key Name of the variable.
+   * @return View
+   */
+  View operator[](std::string const & key);
+
+  /// @copydoc NamedVector::operator[](std::string const &)
+  ConstView operator[](std::string const & key) const;
+
+  /**
+   * @brief Returns a view of the values of the i-th key of the layout (see `FlatIndexMap::find()`).
+   *
+   * @param key_id Position of the key.
+   * @return View
+   */
+  View at(size_t key_id);
+
+  /// @copydoc NamedVector::at(size_t)
+  ConstView at(size_t key_id) const;
+
+  /// @brief Returns a pointer to the packed values (grouped by key).
+  double * data();
+
+  /// @copydoc NamedVector::data()
+  const double * data() const;
+
+  /**
+   * @brief Copy the values of a full value vector (ordered as described by the layout).
+   *
+   * @param values Full value vector (size `size()`).
+   */
+  void from_values(const double * values);
+
+  /**
+   * @brief Copy the values into a full value vector (ordered as described by the layout).
+   *
+   * @param[out] values Full value vector (size `size()`).
+   */
+  void to_values(double * values) const;
+
+  /**
+   * @brief Returns the values as a ValueMap object.
+   *
+   * @return ValueMap
+   */
+  ValueMap to_map() const;
+
+private:
+  std::shared_ptr<const FlatIndexMap> _layout;
+  Eigen::VectorXd _packed_values;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__NAMED_VECTOR_HPP_
@@ -0,0 +1,365 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__SHARED_MEMORY_SOLVER_HPP_
+#define ACADOS_SOLVER_BASE__SHARED_MEMORY_SOLVER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_solver_base/acados_types.hpp"
+
+namespace acados
+{
+
+class SharedMemoryChannel
+/**
+* @brief Shared-memory segment holding two lock-free single-producer/single-consumer rings of fixed-size slots.
+*
+* The request ring (client to host) carries the initial state, the runtime parameters (with the mask of the
+* stages to update), and (optionally) the state and control bounds. The response ring (host to client) carries the status and
+* statistics of the solve, and the state and control trajectories.
+* The layout only depends on the problem dimensions, written in the segment header by the host.
+*
+* @note Used by `SolverHost` and `RemoteSolver`, there is normally no need to use this class directly.
+*/
+{
+public:
+  class Dimensions
+  {
+public:
+    uint32_t nx = 0;
+    uint32_t nu = 0;
+    uint32_t np = 0;
+    uint32_t N = 0;
+    /// @brief Number of state bounds at stages 1 to N-1
+    uint32_t nbx = 0;
+    /// @brief Number of control bounds at stages 0 to N-1
+    uint32_t nbu = 0;
+  };
+
+  /// @brief Request flags (which fields of the request slot are valid).
+  enum RequestFlags : uint32_t
+  {
+    HAS_INITIAL_STATE = 1u << 0,
+    HAS_PARAMETERS = 1u << 1,
+    HAS_STATE_BOUNDS = 1u << 2,
+    HAS_CONTROL_BOUNDS = 1u << 3,
+  };
+
+  struct RequestView
+  {
+    uint64_t * id;
+    uint32_t * flags;
+    /// @brief Initial state (nx).
+    double * x0;
+    /// @brief Runtime parameters (np, N+1), column-major.
+    double * p;
+    /// @brief Stages whose runtime parameters are to be updated (N+1, non-zero if set).
+    uint8_t * p_stages;
+    /// @brief State bounds (nbx, N-1), column-major, stages 1 to N-1.
+    double * lbx;
+    double * ubx;
+    /// @brief Control bounds (nbu, N), column-major.
+    double * lbu;
+    double * ubu;
+  };
+
+  struct ResponseView
+  {
+    uint64_t * id;
+    int32_t * status;
+    int32_t * sqp_iter;
+    int32_t * qp_iter;
+    /// @brief time_tot, time_lin, time_qp, time_reg, res_stat, res_eq, res_ineq, res_comp
+    double * stats;
+    /// @brief State trajectory (nx, N+1), column-major.
+    double * x;
+    /// @brief Control trajectory (nu, N), column-major.
+    double * u;
+  };
+
+  /**
+   * @brief Create (or re-create) the named segment, as done by the host.
+   *
+   * @throws std::runtime_error if the segment cannot be created.
+   *
+   * @param name Name of the segment (see `shm_open()`, e.g., "/my_solver").
+   * @param dims Problem dimensions.
+   * @param capacity Number of slots of each ring.
+   */
+  static std::unique_ptr<SharedMemoryChannel> create(
+    std::string const & name, Dimensions const & dims, uint32_t capacity = 4);
+
+  /**
+   * @brief Open an existing segment, as done by the client.
+   *
+   * Waits until the host has initialized the segment header.
+   *
+   * @throws std::runtime_error if the segment does not exist or is invalid after `timeout`.
+   *
+   * @param name Name of the segment.
+   * @param timeout Maximum waiting time.
+   */
+  static std::unique_ptr<SharedMemoryChannel> open(
+    std::string const & name, std::chrono::nanoseconds timeout);
+
+  /// @brief Unmap the segment (and mark it as closed and unlink it if it was created by this object).
+  ~SharedMemoryChannel();
+
+  SharedMemoryChannel(SharedMemoryChannel const &) = delete;
+  SharedMemoryChannel & operator=(SharedMemoryChannel const &) = delete;
+
+  const std::string & name() const;
+  const Dimensions & dims() const;
+
+  /// @brief Returns the process id of the host.
+  int64_t host_pid() const;
+
+  /// @brief Returns true if the host process is still running (and has not closed the segment).
+  bool is_host_alive() const;
+
+  /// @brief Returns true if the host has closed the segment (e.g., on shutdown or restart).
+  bool is_host_closed() const;
+
+  // Request ring
+
+  /// @brief Returns a view on the next free request slot, false if the ring is full (producer side).
+  bool try_begin_request(RequestView & view);
+  /// @brief Publish the request slot returned by `try_begin_request()`.
+  void commit_request();
+  /// @brief Returns a view on the oldest request, false if the ring is empty (consumer side).
+  bool try_peek_request(RequestView & view);
+  /// @brief Release the request slot returned by `try_peek_request()`.
+  void pop_request();
+
+  // Response ring
+
+  /// @brief Returns a view on the next free response slot, false if the ring is full (producer side).
+  bool try_begin_response(ResponseView & view);
+  /// @brief Publish the response slot returned by `try_begin_response()`.
+  void commit_response();
+  /// @brief Returns a view on the oldest response, false if the ring is empty (consumer side).
+  bool try_peek_response(ResponseView & view);
+  /// @brief Release the response slot returned by `try_peek_response()`.
+  void pop_response();
+
+private:
+  struct Header;
+  struct Ring;
+
+  SharedMemoryChannel() = default;
+
+  /// @brief Compute the slot sizes and the offsets of each section of the segment.
+  void compute_layout(uint32_t capacity);
+
+  RequestView request_view(uint64_t index);
+  ResponseView response_view(uint64_t index);
+
+  std::string _name;
+  bool _owner = false;
+  void * _address = nullptr;
+  size_t _size = 0;
+
+  Dimensions _dims;
+  uint32_t _capacity = 0;
+  size_t _request_slot_size = 0, _response_slot_size = 0;
+
+  Header * _header = nullptr;
+  Ring * _request_ring = nullptr;
+  Ring * _response_ring = nullptr;
+  uint8_t * _request_slots = nullptr;
+  uint8_t * _response_slots = nullptr;
+};
+
+class SolverHost
+/**
+* @brief Serve the solve requests of a `RemoteSolver` through a `SharedMemoryChannel`.
+*
+* Run it in a separate process (see the `acados_solver_host` executable of the `acados_solver_plugins` package)
+* so that a crash of the generated code does not take down the client process.
+*/
+{
+public:
+  /**
+   * @brief Constructor of the SolverHost object, creates the shared-memory segment.
+   *
+   * @throws std::invalid_argument if the solver is not initialized.
+   * @throws std::runtime_error if the segment cannot be created.
+   *
+   * @param solver Initialized solver (must outlive this object).
+   * @param channel_name Name of the shared-memory segment (e.g., "/my_solver").
+   * @param capacity Number of slots of each ring.
+   */
+  SolverHost(AcadosSolver & solver, std::string const & channel_name, uint32_t capacity = 4);
+
+  /**
+   * @brief Process the oldest pending request, if any.
+   *
+   * @return true if a request was processed.
+   */
+  bool serve_once();
+
+  /**
+   * @brief Serve the requests until `stop_requested` is set.
+   *
+   * The host spins for `spin_duration` after each request before yielding the CPU, so that the latency
+   * of periodic requests stays in the microsecond range.
+   *
+   * @param stop_requested Stop flag (e.g., set by a signal handler).
+   * @param spin_duration Busy-waiting duration after the last request.
+   */
+  void serve(
+    std::atomic<bool> const & stop_requested,
+    std::chrono::nanoseconds spin_duration = std::chrono::microseconds(500));
+
+  /// @brief Returns the number of processed requests.
+  size_t num_requests() const;
+
+private:
+  AcadosSolver & _solver;
+  std::unique_ptr<SharedMemoryChannel> _channel;
+  size_t _num_requests = 0;
+};
+
+class RemoteSolver
+/**
+* @brief Client-side proxy of a solver served by a `SolverHost`.
+*
+* The proxy mirrors the subset of the `AcadosSolver` API used in a control loop. The setters only update
+* local buffers, sent with the next `solve()` call, and the getters read the trajectories of the last response.
+* Only the values set through the proxy are sent (e.g., the parameters of the other stages are left untouched
+* in the host). No allocation is performed after construction (except by the `ValueVector` getters and
+* `reconnect()`).
+*
+* If the host is restarted (i.e., the segment is re-created), `solve()` reconnects to the new segment, and
+* all the values set so far through the proxy are sent again with the next request.
+*
+* Typical usage:
+* @code
+* acados::RemoteSolver solver("/my_solver");
+* solver.set_runtime_parameters(p);
+* solver.set_initial_state_values(x0);
+* if (solver.solve() == ACADOS_SUCCESS) {
+*   solver.get_control_values_unchecked(0, u.data());
+* }
+* @endcode
+*/
+{
+public:
+  /// @brief Status returned by `solve()` if no response was received before the timeout.
+  static constexpr int STATUS_TIMEOUT = -2;
+
+  /// @brief Status returned by `solve()` if the host process is not running anymore.
+  static constexpr int STATUS_HOST_DEAD = -3;
+
+  /**
+   * @brief Constructor of the RemoteSolver object, connects to the host.
+   *
+   * @throws std::runtime_error if the segment does not exist or is invalid after `connect_timeout`.
+   *
+   * @param channel_name Name of the shared-memory segment (see `SolverHost`).
+   * @param connect_timeout Maximum waiting time for the host.
+   */
+  explicit RemoteSolver(
+    std::string const & channel_name,
+    std::chrono::nanoseconds connect_timeout = std::chrono::seconds(1));
+
+  unsigned int nx() const;
+  unsigned int nu() const;
+  unsigned int np() const;
+  unsigned int N() const;
+
+  /// @brief Set the initial state (sent with the next `solve()`).
+  int set_initial_state_values(ValueVector const & x_0);
+
+  /// @brief Set the runtime parameters of all stages (sent with the next `solve()`).
+  int set_runtime_parameters(ValueVector const & p_i);
+
+  /// @brief Set the runtime parameters of a given stage (sent with the next `solve()`).
+  int set_runtime_parameters(unsigned int stage, ValueVector const & p_i);
+
+  /// @brief Set the state bounds values of stages 1 to N-1 (sent with the next `solve()`).
+  int set_state_bounds(ValueVector const & lbx, ValueVector const & ubx);
+
+  /// @brief Set the control bounds values of all stages (sent with the next `solve()`).
+  int set_control_bounds(ValueVector const & lbu, ValueVector const & ubu);
+
+  /**
+   * @brief Send the pending changes, solve the OCP in the host process, and wait for the result.
+   *
+   * @param timeout Maximum waiting time for the response.
+   * @return int Acados status, `STATUS_TIMEOUT` or `STATUS_HOST_DEAD`.
+   */
+  int solve(std::chrono::nanoseconds timeout = std::chrono::milliseconds(100));
+
+  /// @brief Returns the statistics of the last solve.
+  const AcadosSolver::SolveStats & solve_stats() const;
+
+  ValueVector get_state_values(unsigned int stage) const;
+  ValueVector get_control_values(unsigned int stage) const;
+
+  /// @brief Unchecked version of `get_state_values()` (x_i of size nx).
+  void get_state_values_unchecked(unsigned int stage, double * x_i) const noexcept;
+
+  /// @brief Unchecked version of `get_control_values()` (u_i of size nu).
+  void get_control_values_unchecked(unsigned int stage, double * u_i) const noexcept;
+
+  /// @brief Returns true if the host process is still running.
+  bool is_host_alive() const;
+
+  /**
+   * @brief Connect to the current segment of the host (e.g., after a restart of the host).
+   *
+   * Called by `solve()` when the host is lost. On success, all the values set so far through the proxy are
+   * sent again with the next request, since the new host starts from the defaults of the plugin.
+   *
+   * @param timeout Maximum waiting time for the host.
+   * @return true if connected to a running host with the same dimensions (else the proxy is unchanged).
+   */
+  bool reconnect(std::chrono::nanoseconds timeout = std::chrono::nanoseconds(0));
+
+private:
+  std::unique_ptr<SharedMemoryChannel> _channel;
+
+  /// @brief Set when the host was found dead or closed, `solve()` then tries to reconnect first.
+  bool _host_lost = false;
+
+  // Pending request
+  uint32_t _flags = 0;
+  /// @brief Stages whose runtime parameters are pending (size N+1).
+  std::vector<uint8_t> _p_stages;
+  Eigen::VectorXd _x0;
+  ColumnMajorXd _p, _lbx, _ubx, _lbu, _ubu;
+  uint64_t _next_id = 1;
+
+  /// @brief Fields and parameter stages sent so far (sent again after a reconnection).
+  uint32_t _sent_flags = 0;
+  std::vector<uint8_t> _sent_p_stages;
+
+  // Last response
+  AcadosSolver::SolveStats _solve_stats;
+  ColumnMajorXd _x_traj, _u_traj;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__SHARED_MEMORY_SOLVER_HPP_
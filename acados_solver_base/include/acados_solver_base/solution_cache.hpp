@@ -0,0 +1,163 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__SOLUTION_CACHE_HPP_
+#define ACADOS_SOLVER_BASE__SOLUTION_CACHE_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_solver_base/acados_types.hpp"
+
+namespace acados
+{
+
+class SolutionCache
+/**
+* @brief Bounded LRU cache of converged solutions, used to warm start the solver from a similar problem.
+*
+* The entries are keyed by the initial state x0 and (optionally) selected runtime parameters of stage 0,
+* quantized on a grid (hashed grid). `seed()` looks for the entry of the same grid cell, or else for
+* the nearest entry (distance expressed in grid cells), and writes its state and control trajectories
+* with `AcadosSolver::initialize_state_values()` / `AcadosSolver::initialize_control_values()`.
+*
+* Typical usage:
+* @code
+* solver.set_initial_state_values(x0);
+* cache.seed(solver, x0);
+* if (solver.solve() == ACADOS_SUCCESS) {
+*   cache.store(solver);
+* }
+* @endcode
+*/
+{
+public:
+  class Options
+  {
+public:
+    /// @brief Maximum number of cached solutions (the least recently used one is evicted).
+    size_t capacity = 32;
+
+    /// @brief Grid resolution of each state variable (size nx, all strictly positive).
+    ValueVector x0_resolution;
+
+    /// @brief Indexes of the runtime parameters included in the key (possibly empty).
+    IndexVector p_indexes;
+
+    /// @brief Grid resolution of the selected runtime parameters (same size as `p_indexes`).
+    ValueVector p_resolution;
+
+    /// @brief Maximum distance (in grid cells) of the nearest neighbour, no seeding beyond.
+    double max_distance = std::numeric_limits<double>::infinity();
+  };
+
+  /**
+   * @brief Constructor of the SolutionCache object.
+   *
+   * @throws std::invalid_argument if the options are inconsistent.
+   *
+   * @param options Cache options.
+   */
+  explicit SolutionCache(Options const & options);
+
+  /**
+   * @brief Store the current solution of the solver (i.e., the x/u trajectories of `ocp_nlp_out`).
+   *
+   * The key is computed from the state at stage 0 and the runtime parameters at stage 0.
+   * The solution is only stored if the last solve succeeded (see `AcadosSolver::solve_stats()`).
+   *
+   * @param solver Initialized solver.
+   * @return true if the solution was stored.
+   */
+  bool store(AcadosSolver & solver);
+
+  /**
+   * @brief Initialize the solver with the cached solution nearest to (x0, p).
+   *
+   * The runtime parameters are read from stage 0 of the solver. The key is computed in preallocated
+   * buffers, so that the lookup does not allocate (except for the first call).
+   *
+   * @param solver Initialized solver (same dimensions as the cached solutions).
+   * @param x0 Initial state of the next solve.
+   * @return true if the solver was initialized from the cache.
+   */
+  bool seed(AcadosSolver & solver, ValueVector const & x0);
+
+  /// @brief Returns the number of cached solutions.
+  size_t size() const;
+
+  /// @brief Remove all cached solutions.
+  void clear();
+
+  /// @brief Returns the number of successful `seed()` calls.
+  size_t hits() const;
+
+  /// @brief Returns the number of `seed()` calls without suitable cached solution.
+  size_t misses() const;
+
+private:
+  struct Entry
+  {
+    /// @brief Quantized key (grid cell).
+    std::vector<int64_t> cell;
+
+    /// @brief Scaled (i.e., divided by the resolution) key values.
+    Eigen::VectorXd scaled_key;
+
+    /// @brief State trajectory (nx, N+1).
+    ColumnMajorXd x_traj;
+
+    /// @brief Control trajectory (nu, N).
+    ColumnMajorXd u_traj;
+  };
+
+  struct CellHash
+  {
+    size_t operator()(std::vector<int64_t> const & cell) const;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  /// @brief Compute `_scaled_key` and `_cell` from x0 and the solver parameters at stage 0.
+  void compute_key(AcadosSolver & solver, const double * x0);
+
+  /// @brief Quantize a scaled key.
+  static void quantize(Eigen::VectorXd const & scaled_key, std::vector<int64_t> & cell);
+
+  Options _options;
+
+  /// @brief Cached entries, the most recently used first.
+  EntryList _entries;
+
+  /// @brief Hashed grid used to find an entry of the same cell in constant time.
+  std::unordered_map<std::vector<int64_t>, EntryList::iterator, CellHash> _grid;
+
+  /// @brief Preallocated buffers of the key computation (`seed()` does not allocate once sized).
+  ValueVector _x0_buffer, _p_buffer;
+  Eigen::VectorXd _scaled_key;
+  std::vector<int64_t> _cell;
+
+  size_t _hits = 0;
+  size_t _misses = 0;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__SOLUTION_CACHE_HPP_
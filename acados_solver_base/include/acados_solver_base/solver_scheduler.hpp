@@ -0,0 +1,213 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__SOLVER_SCHEDULER_HPP_
+#define ACADOS_SOLVER_BASE__SOLVER_SCHEDULER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "acados_solver_base/acados_solver.hpp"
+
+namespace acados
+{
+
+class SolverScheduler
+/**
+* @brief Earliest-deadline-first (EDF) scheduler of several solver instances sharing a set of worker threads.
+*
+* Each task owns a solver and is released periodically. At each release, a job is queued with the absolute
+* deadline `release time + deadline`; the pending jobs are dispatched to the worker threads by increasing
+* deadline. With `TaskOptions::use_rti`, the feedback phase is run at the release and the preparation phase
+* of the next iteration is queued right after, with the next release as deadline.
+*
+* A task never runs concurrently with itself: if its previous job is still pending or running at the next
+* release, the release is dropped (counted as an overrun). Hence, the solvers need not be thread-safe.
+*
+* Typical usage:
+* @code
+* acados::SolverScheduler scheduler({2, {2, 3}});
+* acados::SolverScheduler::TaskOptions task;
+* task.period = std::chrono::milliseconds(10);
+* task.before_solve = [&](acados::AcadosSolver & solver) {solver.set_initial_state_values(x0);};
+* scheduler.add_task(solver, task);
+* scheduler.start();
+* @endcode
+*/
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  class Options
+  {
+public:
+    /// @brief Number of worker threads.
+    unsigned int num_workers = 1;
+
+    /// @brief CPU core of each worker thread (empty to disable pinning, else size `num_workers`).
+    std::vector<int> cpu_cores;
+  };
+
+  class TaskOptions
+  {
+public:
+    /// @brief Release period.
+    std::chrono::nanoseconds period = std::chrono::milliseconds(10);
+
+    /// @brief Relative deadline (zero to use the period).
+    std::chrono::nanoseconds deadline = std::chrono::nanoseconds::zero();
+
+    /// @brief Offset of the first release w.r.t. `start()`.
+    std::chrono::nanoseconds offset = std::chrono::nanoseconds::zero();
+
+    /// @brief Split the solve in feedback (at release) and preparation (before the next release) phases.
+    bool use_rti = false;
+
+    /// @brief Called by the worker before the solve (or feedback phase), e.g., to set the initial state.
+    std::function<void(AcadosSolver &)> before_solve;
+
+    /// @brief Called by the worker after the solve (or feedback phase) with the solver status.
+    std::function<void(AcadosSolver &, int)> after_solve;
+  };
+
+  class TaskStats
+  {
+public:
+    /// @brief Number of releases (including the dropped ones).
+    size_t num_releases = 0;
+
+    /// @brief Number of releases dropped because the previous job was not completed.
+    size_t num_overruns = 0;
+
+    /// @brief Number of completed jobs.
+    size_t num_completed = 0;
+
+    /// @brief Number of jobs completed after their deadline.
+    size_t num_deadline_misses = 0;
+
+    /// @brief Worst response time (from release to completion, in seconds).
+    double max_response_time = 0.0;
+
+    /// @brief Average response time (from release to completion, in seconds).
+    double mean_response_time = 0.0;
+
+    /// @brief Status of the last solve (or feedback phase).
+    int last_status = -1;
+  };
+
+  /**
+   * @brief Constructor of the SolverScheduler object.
+   *
+   * @throws std::invalid_argument if the options are inconsistent.
+   *
+   * @param options Scheduler options.
+   */
+  explicit SolverScheduler(Options const & options);
+
+  /// @brief Stop the scheduler and join all threads.
+  ~SolverScheduler();
+
+  SolverScheduler(SolverScheduler const &) = delete;
+  SolverScheduler & operator=(SolverScheduler const &) = delete;
+
+  /**
+   * @brief Add a task (only before `start()`).
+   *
+   * @throws std::logic_error if the scheduler is running.
+   * @throws std::invalid_argument if the period or the deadline are not strictly positive.
+   *
+   * @param solver Initialized solver (must outlive the scheduler, and not be used elsewhere while running).
+   * @param options Task options.
+   * @return size_t Task index.
+   */
+  size_t add_task(AcadosSolver & solver, TaskOptions const & options);
+
+  /// @brief Returns the number of tasks.
+  size_t num_tasks() const;
+
+  /// @brief Start the dispatcher and worker threads.
+  void start();
+
+  /// @brief Stop the dispatcher and worker threads (the running jobs are completed).
+  void stop();
+
+  /// @brief Returns true if the scheduler is running.
+  bool is_running() const;
+
+  /**
+   * @brief Returns a copy of the statistics of a task.
+   *
+   * @param task_index Task index (see `add_task()`).
+   */
+  TaskStats task_stats(size_t task_index) const;
+
+  /// @brief Reset the statistics of all tasks.
+  void reset_stats();
+
+private:
+  enum class JobType {SOLVE, RTI_FEEDBACK, RTI_PREPARATION};
+
+  struct Job
+  {
+    Clock::time_point deadline;
+    Clock::time_point release;
+    size_t task_index;
+    JobType type;
+  };
+
+  struct Task
+  {
+    AcadosSolver * solver;
+    TaskOptions options;
+    Clock::time_point next_release;
+    /// @brief True while a job of the task is queued or running.
+    bool busy = false;
+    TaskStats stats;
+  };
+
+  /// @brief Comparison used to build a min-heap of jobs w.r.t. their deadline.
+  static bool later_deadline(Job const & lhs, Job const & rhs);
+
+  void dispatcher_loop();
+  void worker_loop(unsigned int worker_index);
+  void run_job(Job const & job);
+
+  /// @brief Push a job into the ready queue (the mutex must be locked).
+  void push_job(Job const & job);
+
+  Options _options;
+  std::vector<Task> _tasks;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _dispatcher_cv, _workers_cv;
+
+  /// @brief Ready jobs (min-heap w.r.t. the deadline).
+  std::vector<Job> _ready_jobs;
+
+  std::atomic<bool> _running {false};
+  std::thread _dispatcher;
+  std::vector<std::thread> _workers;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__SOLVER_SCHEDULER_HPP_
@@ -0,0 +1,132 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#ifndef ACADOS_SOLVER_BASE__TRAJECTORY_INTERPOLATOR_HPP_
+#define ACADOS_SOLVER_BASE__TRAJECTORY_INTERPOLATOR_HPP_
+
+#include <Eigen/Dense>
+
+#include <functional>
+
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_solver_base/acados_types.hpp"
+
+namespace acados
+{
+
+class TrajectoryInterpolator
+/**
+* @brief Continuous-time interpolation of the predicted plan of an `AcadosSolver`.
+*
+* `update()` copies the state and control trajectories of the last solution, together with the
+* (possibly non-uniform) time grid given by `AcadosSolver::sampling_intervals()`.
+* The plan can then be evaluated at any time t in [0, horizon()] (t = 0 is the initial stage):
+*   - u(t) is a zero-order hold of the control trajectory,
+*   - x(t) is a cubic Hermite spline of the state trajectory.
+*
+* The state derivatives at the shooting nodes are given by the dynamics `xdot = f(x, u)` if provided
+* (see `set_dynamics()`), or else estimated by (non-uniform) finite differences of the state trajectory.
+*
+* The evaluation functions never allocate, so they can be called from a high-rate loop
+* while the solver runs at a lower rate.
+*/
+{
+public:
+  /// @brief Continuous-time dynamics `xdot = f(x, u)` (arrays of size nx, nu, and nx respectively).
+  using DynamicsFunction = std::function<void (const double * x, const double * u, double * xdot)>;
+
+  TrajectoryInterpolator() = default;
+
+  /**
+   * @brief Set the dynamics used to compute the state derivatives at the shooting nodes.
+   *
+   * @param dynamics Continuous-time dynamics (if empty, finite differences are used).
+   */
+  void set_dynamics(DynamicsFunction dynamics);
+
+  /**
+   * @brief Copy the trajectories of the last solution.
+   *
+   * The internal storage is only reallocated if the dimensions of the problem change (no allocation
+   * otherwise).
+   *
+   * @param solver Initialized solver.
+   * @return int Status (zero if all OK).
+   */
+  int update(AcadosSolver & solver);
+
+  /// @brief Returns true if `update()` was called at least once.
+  bool is_ready() const;
+
+  /// @brief Returns the duration of the horizon (in seconds).
+  double horizon() const;
+
+  /// @brief Returns the time of a shooting node (in seconds, stage in [0, N]).
+  double node_time(unsigned int stage) const;
+
+  /**
+   * @brief Evaluate the state at time t (clamped to [0, horizon()]).
+   *
+   * @param[in] t Time since the initial stage (in seconds).
+   * @param[out] x State values (size nx).
+   */
+  void evaluate_state(double t, Eigen::Ref<Eigen::VectorXd> x) const;
+
+  /**
+   * @brief Evaluate the control at time t (clamped to [0, horizon()]).
+   *
+   * @param[in] t Time since the initial stage (in seconds).
+   * @param[out] u Control values (size nu).
+   */
+  void evaluate_control(double t, Eigen::Ref<Eigen::VectorXd> u) const;
+
+  /**
+   * @brief Evaluate the state and control at several times at once.
+   *
+   * @param[in] times Evaluation times (in seconds).
+   * @param[out] x_traj State values (size (nx, times.size())).
+   * @param[out] u_traj Control values (size (nu, times.size())).
+   */
+  void evaluate(
+    Eigen::Ref<const Eigen::VectorXd> times,
+    Eigen::Ref<ColumnMajorXd> x_traj,
+    Eigen::Ref<ColumnMajorXd> u_traj) const;
+
+private:
+  /// @brief Returns the interval k such that t_k <= t < t_{k+1} (t is clamped).
+  unsigned int find_interval(double & t) const;
+
+  /// @brief Compute the state derivatives at the shooting nodes.
+  void compute_derivatives();
+
+  DynamicsFunction _dynamics;
+
+  /// @brief Time of the shooting nodes (size N+1).
+  Eigen::VectorXd _t;
+
+  /// @brief State trajectory (nx, N+1).
+  ColumnMajorXd _x;
+
+  /// @brief State derivatives at the shooting nodes (nx, N+1).
+  ColumnMajorXd _dx;
+
+  /// @brief Control trajectory (nu, N).
+  ColumnMajorXd _u;
+};
+
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_BASE__TRAJECTORY_INTERPOLATOR_HPP_
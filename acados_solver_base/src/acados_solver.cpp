@@ -15,6 +15,8 @@
 // Author: Thibault Poignonec (tpoignonec@unistra.fr)
 
 #include "acados_solver_base/acados_solver.hpp"
+#include <cassert>
+#include <limits>
 #include <numeric>  // for std::iota
 #include <stdexcept>
 
@@ -22,6 +24,10 @@ namespace acados
 {
 
 AcadosSolver::AcadosSolver()
+: _x_flat_index_map(std::make_shared<FlatIndexMap>()),
+  _z_flat_index_map(std::make_shared<FlatIndexMap>()),
+  _p_flat_index_map(std::make_shared<FlatIndexMap>()),
+  _u_flat_index_map(std::make_shared<FlatIndexMap>())
 {
 }
 
@@ -37,29 +43,54 @@ int AcadosSolver::init(unsigned int N, double Ts)
   std::vector<double> time_steps_vect(N, Ts);
   status = internal_create_with_discretization(N, time_steps_vect.data());
   _Ts = Ts;
+  cache_nlp_handles();
 
   // Create index maps
   status = create_index_maps();
   if (!is_map_size_consistent(_x_index_map, nx())) {
     status = 1;
-    std::cerr << "Inconsistent index map for diff. state variables x!" << std::endl;
+    _logger.log(LogLevel::ERROR, "Inconsistent index map for diff. state variables x!");
   }
   if (!is_map_size_consistent(_z_index_map, nz())) {
     status = 1;
-    std::cerr << "Inconsistent index map for algebraic state variables z!" << std::endl;
+    _logger.log(LogLevel::ERROR, "Inconsistent index map for algebraic state variables z!");
   }
   if (!is_map_size_consistent(_p_index_map, np())) {
     status = 1;
-    std::cerr << "Inconsistent index map for runtime parameters variables p!" << std::endl;
+    _logger.log(LogLevel::ERROR, "Inconsistent index map for runtime parameters variables p!");
   }
   if (!is_map_size_consistent(_u_index_map, nu())) {
     status = 1;
-    std::cerr << "Inconsistent index map for control variables u!" << std::endl;
+    _logger.log(LogLevel::ERROR, "Inconsistent index map for control variables u!");
   }
   if (status > 0) {
-    std::cerr << "ERROR: the index maps could not be initialized correctly!" << std::endl;
+    _logger.log(LogLevel::ERROR, "The index maps could not be initialized correctly!");
     return 1;
   }
+  _x_flat_index_map = std::make_shared<FlatIndexMap>(_x_index_map);
+  _z_flat_index_map = std::make_shared<FlatIndexMap>(_z_index_map);
+  _p_flat_index_map = std::make_shared<FlatIndexMap>(_p_index_map);
+  _u_flat_index_map = std::make_shared<FlatIndexMap>(_u_index_map);
+  _x_buffer.assign(nx(), 0.0);
+  _z_buffer.assign(nz(), 0.0);
+  _p_buffer.assign(np(), 0.0);
+  _u_buffer.assign(nu(), 0.0);
+  _S_forw_buffer.assign(nx() * (nx() + nu()), 0.0);
+
+  // Indexes of the runtime parameters, as expected by the sparse parameter update
+  _p_sparse_indexes.clear();
+  for (auto const & [key, indexes] : _p_index_map) {
+    _p_sparse_indexes[key] = std::vector<int>(indexes.begin(), indexes.end());
+  }
+
+  // Indexes used to set the initial state
+  _idxbx_0.resize(nx());
+  std::iota(std::begin(_idxbx_0), std::end(_idxbx_0), 0);    // Fill with 0, 1, ..., nx()-1.
+
+  // Allocate linear feedback buffers
+  _feedback_gain.setZero(nu(), nx());
+  _feedback_x0.setZero(nx());
+  _feedback_u0.setZero(nu());
 
   return reset();
 }
@@ -71,8 +102,28 @@ int AcadosSolver::reset()
 }
 
 
+void AcadosSolver::cache_nlp_handles()
+{
+  _nlp_config = get_nlp_config();
+  _nlp_dims = get_nlp_dims();
+  _nlp_in = get_nlp_in();
+  _nlp_out = get_nlp_out();
+  _nlp_solver = get_nlp_solver();
+  _sens_out = get_sens_out();
+  _nlp_opts = get_nlp_opts();
+  _N = static_cast<unsigned int>(_nlp_dims->N);
+}
+
 int AcadosSolver::free_memory()
 {
+  _nlp_config = nullptr;
+  _nlp_dims = nullptr;
+  _nlp_in = nullptr;
+  _nlp_out = nullptr;
+  _nlp_solver = nullptr;
+  _sens_out = nullptr;
+  _nlp_opts = nullptr;
+  _N = 0;
   int status = internal_free();
   // TODO(tpoignonec): test all OK
   status = internal_free_capsule();
@@ -82,27 +133,33 @@ int AcadosSolver::free_memory()
 
 int AcadosSolver::solve()
 {
-  bool use_rti = get_nlp_config()->is_real_time_algorithm();
+  bool use_rti = _nlp_config->is_real_time_algorithm();
   int solver_status = -1;
 
   if (use_rti) {
     // RTI preparation stage
     solver_status = solve_rti(RtiStage::PREPARATION);
     if (solver_status != ACADOS_READY && solver_status != ACADOS_SUCCESS) {
-      std::cerr << "Aborting RTI solve() at preparation stage!" << std::endl;
+      _logger.log(LogLevel::WARNING, "Aborting RTI solve() at preparation stage!");
       return solver_status;
     }
-    // RTI feedback stage
+    // RTI feedback stage (the timings of both stages are accumulated)
+    const SolveStats preparation_stats = _solve_stats;
     solver_status = solve_rti(RtiStage::FEEDBACK);
+    _solve_stats.time_tot += preparation_stats.time_tot;
+    _solve_stats.time_lin += preparation_stats.time_lin;
+    _solve_stats.time_qp += preparation_stats.time_qp;
+    _solve_stats.time_reg += preparation_stats.time_reg;
   } else {
     // Vanilla solve
     solver_status = internal_solve();
+    update_solve_stats(solver_status);
   }
 
   if (solver_status != ACADOS_SUCCESS) {
-    std::cerr << "WARNING! AcadosSolver::solve() failed with status " << solver_status << '!' <<
-      std::endl;
-    std::cerr << "Realtime mode: " << (use_rti ? "ON" : "OFF") << std::endl;
+    _logger.log(LogLevel::WARNING,
+      "AcadosSolver::solve() failed with status %d! Realtime mode: %s",
+      solver_status, use_rti ? "ON" : "OFF");
   }
   return solver_status;
 }
@@ -113,49 +170,113 @@ int AcadosSolver::solve_rti(RtiStage rti_phase)
 
   // RTI initialization stage (optional)
   if (_rti_phase < 0) {
-    std::cout << "Attempting to initialize the solver with RTI!" << std::endl;
+    _logger.log(LogLevel::INFO, "Attempting to initialize the solver with RTI!");
     for (size_t attempt_nb = 0; attempt_nb < 10; attempt_nb++) {
       rti_status = internal_solve();
     }
     if (rti_status != ACADOS_READY && rti_status != ACADOS_SUCCESS) {
-      std::cerr << "WARNING! AcadosSolver::solve() failed to initialize with status " <<
-        rti_status << '!' <<
-        std::endl;
+      _logger.log(LogLevel::WARNING,
+        "AcadosSolver::solve() failed to initialize with status %d!", rti_status);
       return rti_status;
     }
   }
 
   if (rti_phase != RtiStage::PREPARATION && rti_phase != RtiStage::FEEDBACK) {
-    std::cerr << "ERROR! AcadosSolver::solve_rti() called with an invalid RTI phase!" << std::endl;
+    _logger.log(LogLevel::ERROR, "AcadosSolver::solve_rti() called with an invalid RTI phase!");
     return -1;  // Not standard Acados status code...
   }
 
   if (rti_phase == RtiStage::PREPARATION) {
     _rti_phase = 1;
-    ocp_nlp_solver_opts_set(get_nlp_config(), get_nlp_opts(), "rti_phase", &_rti_phase);
+    ocp_nlp_solver_opts_set(_nlp_config, _nlp_opts, "rti_phase", &_rti_phase);
     rti_status = internal_solve();
+    update_solve_stats(rti_status);
     if (rti_status != ACADOS_READY && rti_status != ACADOS_SUCCESS) {
-      std::cerr <<
-        "WARNING! AcadosSolver::solve() failed during RTI preparation stage with status " <<
-        rti_status << '!' <<
-        std::endl;
+      _logger.log(LogLevel::WARNING,
+        "AcadosSolver::solve() failed during RTI preparation stage with status %d!", rti_status);
       return rti_status;
     }
   } else {
     // RTI feedback stage
     _rti_phase = 2;
-    ocp_nlp_solver_opts_set(get_nlp_config(), get_nlp_opts(), "rti_phase", &_rti_phase);
+    ocp_nlp_solver_opts_set(_nlp_config, _nlp_opts, "rti_phase", &_rti_phase);
     rti_status = internal_solve();
+    update_solve_stats(rti_status);
     if (rti_status != ACADOS_SUCCESS) {
-      std::cerr << "WARNING! AcadosSolver::solve() failed during RTI feedback stage with status " <<
-        rti_status << '!' <<
-        std::endl;
+      _logger.log(LogLevel::WARNING,
+        "AcadosSolver::solve() failed during RTI feedback stage with status %d!", rti_status);
       return rti_status;
     }
   }
   return rti_status;
 }
 
+const AcadosSolver::SolveStats & AcadosSolver::solve_stats() const
+{
+  return _solve_stats;
+}
+
+void AcadosSolver::set_delay_compensation(DelayCompensation mode, double latency)
+{
+  if (mode == DelayCompensation::CONFIGURED && latency < 0.0) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::set_delay_compensation()': the latency must be positive!";
+    throw std::invalid_argument(err_msg);
+  }
+  _delay_compensation = mode;
+  _delay_compensation_latency = latency;
+}
+
+double AcadosSolver::delay_compensation_latency() const
+{
+  switch (_delay_compensation) {
+    case DelayCompensation::CONFIGURED:
+      return _delay_compensation_latency;
+    case DelayCompensation::MEASURED:
+      return (_solve_stats.status < 0) ? 0.0 : _solve_stats.time_tot;
+    default:
+      return 0.0;
+  }
+}
+
+ValueVector & AcadosSolver::compensate_delay(ValueVector & x_0)
+{
+  const double latency = delay_compensation_latency();
+  if (latency <= 0.0) {
+    return x_0;
+  }
+  _delay_x_pred.resize(nx());
+  _delay_z.resize(nz());
+  _delay_p.resize(np());
+  _delay_u.resize(nu());
+  get_control_values_unchecked(0, _delay_u.data());
+  ocp_nlp_in_get(_nlp_config, _nlp_dims, _nlp_in, 0, "p", _delay_p.data());
+  int status = simulate(latency, x_0, _delay_u, _delay_p, _delay_x_pred, _delay_z);
+  if (status != 0) {
+    _logger.log(
+      LogLevel::WARNING,
+      "Delay compensation failed (simulation status %d), the measured initial state is used!",
+      status);
+    return x_0;
+  }
+  return _delay_x_pred;
+}
+
+void AcadosSolver::update_solve_stats(int status)
+{
+  ocp_nlp_get(_nlp_solver, "time_tot", &_solve_stats.time_tot);
+  ocp_nlp_get(_nlp_solver, "time_lin", &_solve_stats.time_lin);
+  ocp_nlp_get(_nlp_solver, "time_qp", &_solve_stats.time_qp);
+  ocp_nlp_get(_nlp_solver, "time_reg", &_solve_stats.time_reg);
+  ocp_nlp_get(_nlp_solver, "sqp_iter", &_solve_stats.sqp_iter);
+  ocp_nlp_get(_nlp_solver, "qp_iter", &_solve_stats.qp_iter);
+  ocp_nlp_get(_nlp_solver, "res_stat", &_solve_stats.res_stat);
+  ocp_nlp_get(_nlp_solver, "res_eq", &_solve_stats.res_eq);
+  ocp_nlp_get(_nlp_solver, "res_ineq", &_solve_stats.res_ineq);
+  ocp_nlp_get(_nlp_solver, "res_comp", &_solve_stats.res_comp);
+  _solve_stats.status = status;
+}
+
 //####################################################
 //                  SIMULATION
 //####################################################
@@ -169,15 +290,16 @@ int AcadosSolver::simulate(
   ValueVector & z)
 {
   if (dt <= 0.0) {
-    std::cerr << "Error in 'AcadosSolver::simulate()': Invalid time step, got " << dt << std::endl;
+    _logger.log(
+      LogLevel::ERROR, "Error in 'AcadosSolver::simulate()': Invalid time step, got %g", dt);
     return 10;  // Error: Invalid time step
   }
   if (x0.size() != nx() || u0.size() != nu() || p.size() != np()) {
-    std::cerr << "Error in 'AcadosSolver::simulate()': Inconsistent parameters!" << std::endl;
+    _logger.log(LogLevel::ERROR, "Error in 'AcadosSolver::simulate()': Inconsistent parameters!");
     return 11;  // Error: Inconsistent parameters
   }
   if (x_next.size() != nx() || z.size() != nz()) {
-    std::cerr << "Error in 'AcadosSolver::simulate()': Inconsistent output sizes!" << std::endl;
+    _logger.log(LogLevel::ERROR, "Error in 'AcadosSolver::simulate()': Inconsistent output sizes!");
     return 12;  // Error: Inconsistent output sizes
   }
 
@@ -203,22 +325,19 @@ int AcadosSolver::simulate(
   {
     return 1;  // Error: Incomplete values map
   }
-  std::vector<double> x0, u0, p;
-  x0.reserve(nx());
-  u0.reserve(nu());
-  p.reserve(np());
-  fill_vector_from_map(x_index_map(), x0_map, nx(), x0);
-  fill_vector_from_map(u_index_map(), u0_map, nu(), u0);
-  fill_vector_from_map(p_index_map(), p_map, np(), p);
+  std::vector<double> x0(nx()), u0(nu()), p(np());
+  _x_flat_index_map->fill_vector_from_map(x0_map, x0.data());
+  _u_flat_index_map->fill_vector_from_map(u0_map, u0.data());
+  _p_flat_index_map->fill_vector_from_map(p_map, p.data());
   std::vector<double> x_next(nx()), z(nz());
 
   int status = simulate(dt, x0, u0, p, x_next, z);
-  fill_map_from_values(x_index_map(), x_next, x_next_map);
-  fill_map_from_values(z_index_map(), z, z_map);
+  _x_flat_index_map->fill_map_from_values(x_next.data(), x_next_map);
+  _z_flat_index_map->fill_map_from_values(z.data(), z_map);
 
   if (status != 0) {
-    std::cerr << "Error in 'AcadosSolver::simulate()': Simulation failed with status " << status <<
-      std::endl;
+    _logger.log(LogLevel::ERROR,
+      "Error in 'AcadosSolver::simulate()': Simulation failed with status %d", status);
   }
 
   return status;  // Error: Simulation failed
@@ -241,6 +360,61 @@ int AcadosSolver::simulate(
     z_map);
 }
 
+int AcadosSolver::simulate_with_sensitivities(
+  double dt,
+  ValueVector & x0,
+  ValueVector & u0,
+  ValueVector & p,
+  ValueVector & x_next,
+  ValueVector & z,
+  ColumnMajorXd & dx_next_dx0,
+  ColumnMajorXd & dx_next_du)
+{
+  if (dt <= 0.0) {
+    _logger.log(LogLevel::ERROR,
+      "Error in 'AcadosSolver::simulate_with_sensitivities()': Invalid time step, got %g", dt);
+    return 10;  // Error: Invalid time step
+  }
+  if (x0.size() != nx() || u0.size() != nu() || p.size() != np()) {
+    _logger.log(LogLevel::ERROR,
+      "Error in 'AcadosSolver::simulate_with_sensitivities()': Inconsistent parameters!");
+    return 11;  // Error: Inconsistent parameters
+  }
+  if (x_next.size() != nx() || z.size() != nz() ||
+    dx_next_dx0.rows() != nx() || dx_next_dx0.cols() != nx() ||
+    dx_next_du.rows() != nx() || dx_next_du.cols() != nu())
+  {
+    _logger.log(LogLevel::ERROR,
+      "Error in 'AcadosSolver::simulate_with_sensitivities()': Inconsistent output sizes!");
+    return 12;  // Error: Inconsistent output sizes
+  }
+
+  int status = internal_simulate_with_sensitivities(
+    dt, x0.data(), u0.data(), p.data(), x_next.data(), z.data(), _S_forw_buffer.data());
+  if (status != 0) {
+    return status;
+  }
+  // S_forw = [dx_next/dx0, dx_next/du] (column-major)
+  dx_next_dx0 = Eigen::Map<const ColumnMajorXd>(_S_forw_buffer.data(), nx(), nx());
+  dx_next_du = Eigen::Map<const ColumnMajorXd>(_S_forw_buffer.data() + nx() * nx(), nx(), nu());
+  return 0;
+}
+
+int AcadosSolver::internal_simulate_with_sensitivities(
+  double /*dt*/,
+  double * /*x0*/,
+  double * /*u0*/,
+  double * /*p*/,
+  double * /*x_next*/,
+  double * /*z_next*/,
+  double * /*S_forw*/)
+{
+  _logger.log(LogLevel::ERROR,
+    "Error in 'AcadosSolver::simulate_with_sensitivities()': "
+    "Forward sensitivities are not supported by this plugin (regenerate it)!");
+  return 13;  // Error: Not supported
+}
+
 //####################################################
 //                     SETTERS
 //####################################################
@@ -256,9 +430,8 @@ int AcadosSolver::set_initial_state_values(ValueVector & x_0)
       "Inconsistent parameters, the size of x_0 should match nx!";
     throw std::range_error(err_msg);
   }
-  IndexVector idxbx0(nx());
-  std::iota(std::begin(idxbx0), std::end(idxbx0), 0);    // Fill with 0, 1, ..., nx()-1.
-  set_state_bounds(0, idxbx0, x_0, x_0);
+  ValueVector & x_0_compensated = compensate_delay(x_0);
+  set_state_bounds(0, _idxbx_0, x_0_compensated, x_0_compensated);
   return 0;
 }
 
@@ -267,12 +440,21 @@ int AcadosSolver::set_initial_state_values(ValueMap const & x_0_map)
   if (!is_values_map_complete(x_index_map(), x_0_map)) {
     return 1;
   }
-  std::vector<double> x_0;
-  x_0.reserve(nx());
-  fill_vector_from_map(x_index_map(), x_0_map, nx(), x_0);
+  std::vector<double> x_0(nx());
+  _x_flat_index_map->fill_vector_from_map(x_0_map, x_0.data());
   return set_initial_state_values(x_0);
 }
 
+int AcadosSolver::set_initial_state_values(NamedVector const & x_0)
+{
+  if (!is_named_vector_consistent(x_0, _x_flat_index_map)) {
+    _logger.log(LogLevel::WARNING, "Failed to set x_0, the NamedVector layout is invalid!");
+    return 1;
+  }
+  x_0.to_values(_x_buffer.data());
+  return set_initial_state_values(_x_buffer);
+}
+
 // ------------------------------------------
 // Bounds and constraints
 // ------------------------------------------
@@ -308,23 +490,27 @@ int AcadosSolver::set_state_bounds(
     throw std::range_error(err_msg);
   }
   ocp_nlp_constraints_model_set(
-    get_nlp_config(),
-    get_nlp_dims(),
-    get_nlp_in(),
-    get_nlp_out(),
+    _nlp_config,
+    _nlp_dims,
+    _nlp_in,
+    _nlp_out,
     stage, "idxbx", idxbx.data());
   ocp_nlp_constraints_model_set(
-    get_nlp_config(),
-    get_nlp_dims(),
-    get_nlp_in(),
-    get_nlp_out(),
+    _nlp_config,
+    _nlp_dims,
+    _nlp_in,
+    _nlp_out,
     stage, "lbx", lbx.data());
   ocp_nlp_constraints_model_set(
-    get_nlp_config(),
-    get_nlp_dims(),
-    get_nlp_in(),
-    get_nlp_out(),
+    _nlp_config,
+    _nlp_dims,
+    _nlp_in,
+    _nlp_out,
     stage, "ubx", ubx.data());
+  // Invalidate the values cached by set_state_bounds_trajectory()
+  if (stage < _lbx_cache.cols()) {
+    _lbx_cache.col(stage).setConstant(std::numeric_limits<double>::quiet_NaN());
+  }
   return 0;
 }
 
@@ -363,23 +549,27 @@ int AcadosSolver::set_control_bounds(
     throw std::range_error(err_msg);
   }
   ocp_nlp_constraints_model_set(
-    get_nlp_config(),
-    get_nlp_dims(),
-    get_nlp_in(),
-    get_nlp_out(),
+    _nlp_config,
+    _nlp_dims,
+    _nlp_in,
+    _nlp_out,
     stage, "idxbu", idxbu.data());
   ocp_nlp_constraints_model_set(
-    get_nlp_config(),
-    get_nlp_dims(),
-    get_nlp_in(),
-    get_nlp_out(),
+    _nlp_config,
+    _nlp_dims,
+    _nlp_in,
+    _nlp_out,
     stage, "lbu", lbu.data());
   ocp_nlp_constraints_model_set(
-    get_nlp_config(),
-    get_nlp_dims(),
-    get_nlp_in(),
-    get_nlp_out(),
+    _nlp_config,
+    _nlp_dims,
+    _nlp_in,
+    _nlp_out,
     stage, "ubu", ubu.data());
+  // Invalidate the values cached by set_control_bounds_trajectory()
+  if (stage < _lbu_cache.cols()) {
+    _lbu_cache.col(stage).setConstant(std::numeric_limits<double>::quiet_NaN());
+  }
   return 0;
 }
 
@@ -392,15 +582,133 @@ int AcadosSolver::set_control_bounds(IndexVector & idxbu, ValueVector & lbu, Val
   return 0;
 }
 
+int AcadosSolver::set_state_bounds_trajectory(
+  unsigned int first_stage,
+  IndexVector & idxbx,
+  ColumnMajorXd const & lbx_traj,
+  ColumnMajorXd const & ubx_traj,
+  bool only_changed)
+{
+  const unsigned int n_stages = static_cast<unsigned int>(lbx_traj.cols());
+  if (n_stages == 0 || first_stage + n_stages > N() + 1) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::set_state_bounds_trajectory()': Invalid stage range request!";
+    throw std::range_error(err_msg);
+  }
+  if (lbx_traj.rows() != static_cast<Eigen::Index>(idxbx.size()) ||
+    ubx_traj.rows() != lbx_traj.rows() || ubx_traj.cols() != lbx_traj.cols())
+  {
+    std::string err_msg =
+      "Error in 'AcadosSolver::set_state_bounds_trajectory()': "
+      "Inconsistent parameters (lbx_traj and ubx_traj should be of size idxbx.size() x n_stages)!";
+    throw std::range_error(err_msg);
+  }
+  for (unsigned int stage = first_stage; stage < first_stage + n_stages; stage++) {
+    unsigned int expected_dim;
+    if (stage == 0) {
+      expected_dim = dims().nbx_0;
+    } else if (stage < N()) {
+      expected_dim = dims().nbx;
+    } else {
+      expected_dim = dims().nbx_N;
+    }
+    if (idxbx.size() != expected_dim) {
+      std::string err_msg =
+        "Error in 'AcadosSolver::set_state_bounds_trajectory()': "
+        "Inconsistent parameters! The size of idxbx should be of dimension ";
+      err_msg += std::to_string(expected_dim) + " at stage " + std::to_string(stage);
+      throw std::range_error(err_msg);
+    }
+  }
+  return write_bounds_trajectory(
+    "idxbx", "lbx", "ubx", first_stage, idxbx, lbx_traj, ubx_traj, only_changed,
+    _idxbx_cache, _lbx_cache, _ubx_cache);
+}
+
+int AcadosSolver::set_control_bounds_trajectory(
+  unsigned int first_stage,
+  IndexVector & idxbu,
+  ColumnMajorXd const & lbu_traj,
+  ColumnMajorXd const & ubu_traj,
+  bool only_changed)
+{
+  const unsigned int n_stages = static_cast<unsigned int>(lbu_traj.cols());
+  if (n_stages == 0 || first_stage + n_stages > N()) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::set_control_bounds_trajectory()': Invalid stage range request!";
+    throw std::range_error(err_msg);
+  }
+  if (lbu_traj.rows() != static_cast<Eigen::Index>(idxbu.size()) ||
+    ubu_traj.rows() != lbu_traj.rows() || ubu_traj.cols() != lbu_traj.cols())
+  {
+    std::string err_msg =
+      "Error in 'AcadosSolver::set_control_bounds_trajectory()': "
+      "Inconsistent parameters (lbu_traj and ubu_traj should be of size idxbu.size() x n_stages)!";
+    throw std::range_error(err_msg);
+  }
+  if (idxbu.size() != dims().nbu) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::set_control_bounds_trajectory()': "
+      "Inconsistent parameters (the size of idxbu should be of length ";
+    err_msg += std::to_string(dims().nbu);
+    throw std::range_error(err_msg);
+  }
+  return write_bounds_trajectory(
+    "idxbu", "lbu", "ubu", first_stage, idxbu, lbu_traj, ubu_traj, only_changed,
+    _idxbu_cache, _lbu_cache, _ubu_cache);
+}
+
+int AcadosSolver::write_bounds_trajectory(
+  const char * idx_field,
+  const char * lb_field,
+  const char * ub_field,
+  unsigned int first_stage,
+  IndexVector & idx,
+  ColumnMajorXd const & lb_traj,
+  ColumnMajorXd const & ub_traj,
+  bool only_changed,
+  IndexVector & idx_cache,
+  ColumnMajorXd & lb_cache,
+  ColumnMajorXd & ub_cache)
+{
+  // (Re)allocate the cache if the bounded variables changed
+  if (idx != idx_cache || lb_cache.rows() != lb_traj.rows() || lb_cache.cols() != N() + 1) {
+    idx_cache = idx;
+    lb_cache.setConstant(lb_traj.rows(), N() + 1, std::numeric_limits<double>::quiet_NaN());
+    ub_cache.setConstant(ub_traj.rows(), N() + 1, std::numeric_limits<double>::quiet_NaN());
+  }
+  for (unsigned int i = 0; i < lb_traj.cols(); i++) {
+    const unsigned int stage = first_stage + i;
+    // Note: NaN values in the cache never compare equal, so unknown stages are always written
+    if (only_changed &&
+      lb_cache.col(stage) == lb_traj.col(i) && ub_cache.col(stage) == ub_traj.col(i))
+    {
+      continue;
+    }
+    ocp_nlp_constraints_model_set(
+      _nlp_config, _nlp_dims, _nlp_in, _nlp_out,
+      stage, idx_field, idx.data());
+    ocp_nlp_constraints_model_set(
+      _nlp_config, _nlp_dims, _nlp_in, _nlp_out,
+      stage, lb_field, const_cast<double *>(lb_traj.col(i).data()));
+    ocp_nlp_constraints_model_set(
+      _nlp_config, _nlp_dims, _nlp_in, _nlp_out,
+      stage, ub_field, const_cast<double *>(ub_traj.col(i).data()));
+    lb_cache.col(stage) = lb_traj.col(i);
+    ub_cache.col(stage) = ub_traj.col(i);
+  }
+  return 0;
+}
+
 // ------------------------------------------
 // Solver state/control values initialization
 // ------------------------------------------
 int AcadosSolver::initialize_state_values(unsigned int stage, ValueVector & x_i)
 {
   if (x_i.size() != nx()) {
-    std::cerr << "WARNING: Failed to set x_" << stage << "!"
-              << "A vector of length " << nx() << " is expected (" << x_i.size() << " provided)." <<
-      std::endl;
+    _logger.log(LogLevel::WARNING,
+      "Failed to set x_%u! A vector of length %u is expected (%zu provided).",
+      stage, nx(), static_cast<size_t>(x_i.size()));
     return 1;
   }
   if (stage > N()) {
@@ -409,10 +717,10 @@ int AcadosSolver::initialize_state_values(unsigned int stage, ValueVector & x_i)
     throw std::range_error(err_msg);
   }
   ocp_nlp_out_set(
-    get_nlp_config(),
-    get_nlp_dims(),
-    get_nlp_out(),
-    get_nlp_in(),
+    _nlp_config,
+    _nlp_dims,
+    _nlp_out,
+    _nlp_in,
     stage, "x", x_i.data()
   );
   return 0;
@@ -423,12 +731,21 @@ int AcadosSolver::initialize_state_values(unsigned int stage, ValueMap const & x
   if (!is_values_map_complete(x_index_map(), x_i_map)) {
     return 1;
   }
-  std::vector<double> x_i;
-  x_i.reserve(nx());
-  fill_vector_from_map(x_index_map(), x_i_map, nx(), x_i);
+  std::vector<double> x_i(nx());
+  _x_flat_index_map->fill_vector_from_map(x_i_map, x_i.data());
   return initialize_state_values(stage, x_i);
 }
 
+int AcadosSolver::initialize_state_values(unsigned int stage, NamedVector const & x_i)
+{
+  if (!is_named_vector_consistent(x_i, _x_flat_index_map)) {
+    _logger.log(LogLevel::WARNING, "Failed to set x_%u, the NamedVector layout is invalid!", stage);
+    return 1;
+  }
+  x_i.to_values(_x_buffer.data());
+  return initialize_state_values(stage, _x_buffer);
+}
+
 int AcadosSolver::initialize_state_values(ValueVector & x_i)
 {
   int status = 0;
@@ -444,18 +761,28 @@ int AcadosSolver::initialize_state_values(ValueMap const & x_i_map)
   if (!is_values_map_complete(x_index_map(), x_i_map)) {
     return 1;
   }
-  std::vector<double> x_i;
-  x_i.reserve(nx());
-  fill_vector_from_map(x_index_map(), x_i_map, nx(), x_i);
+  std::vector<double> x_i(nx());
+  _x_flat_index_map->fill_vector_from_map(x_i_map, x_i.data());
   return initialize_state_values(x_i);
 }
 
+int AcadosSolver::initialize_state_values(NamedVector const & x_i)
+{
+  if (!is_named_vector_consistent(x_i, _x_flat_index_map)) {
+    _logger.log(
+      LogLevel::WARNING, "Failed to set x (all stages), the NamedVector layout is invalid!");
+    return 1;
+  }
+  x_i.to_values(_x_buffer.data());
+  return initialize_state_values(_x_buffer);
+}
+
 int AcadosSolver::initialize_control_values(unsigned int stage, ValueVector & u_i)
 {
   if (u_i.size() != nu()) {
-    std::cerr << "WARNING: Failed to set u_" << stage << "!"
-              << "A vector of length " << nu() << " is expected (" << u_i.size() << " provided)." <<
-      std::endl;
+    _logger.log(LogLevel::WARNING,
+      "Failed to set u_%u! A vector of length %u is expected (%zu provided).",
+      stage, nu(), static_cast<size_t>(u_i.size()));
     return 1;
   }
   if (stage >= N()) {
@@ -464,10 +791,10 @@ int AcadosSolver::initialize_control_values(unsigned int stage, ValueVector & u_
     throw std::range_error(err_msg);
   }
   ocp_nlp_out_set(
-    get_nlp_config(),
-    get_nlp_dims(),
-    get_nlp_out(),
-    get_nlp_in(),
+    _nlp_config,
+    _nlp_dims,
+    _nlp_out,
+    _nlp_in,
     stage, "u", u_i.data()
   );
   return 0;
@@ -477,11 +804,20 @@ int AcadosSolver::initialize_control_values(unsigned int stage, ValueMap const &
   if (!is_values_map_complete(u_index_map(), u_i_map)) {
     return 1;
   }
-  std::vector<double> u_i;
-  u_i.reserve(nu());
-  fill_vector_from_map(u_index_map(), u_i_map, nu(), u_i);
+  std::vector<double> u_i(nu());
+  _u_flat_index_map->fill_vector_from_map(u_i_map, u_i.data());
   return initialize_control_values(stage, u_i);
 }
+
+int AcadosSolver::initialize_control_values(unsigned int stage, NamedVector const & u_i)
+{
+  if (!is_named_vector_consistent(u_i, _u_flat_index_map)) {
+    _logger.log(LogLevel::WARNING, "Failed to set u_%u, the NamedVector layout is invalid!", stage);
+    return 1;
+  }
+  u_i.to_values(_u_buffer.data());
+  return initialize_control_values(stage, _u_buffer);
+}
 int AcadosSolver::initialize_control_values(ValueVector & u_i)
 {
   int status = 0;
@@ -496,12 +832,22 @@ int AcadosSolver::initialize_control_values(ValueMap const & u_i_map)
   if (!is_values_map_complete(u_index_map(), u_i_map)) {
     return 1;
   }
-  std::vector<double> u_i;
-  u_i.reserve(nu());
-  fill_vector_from_map(u_index_map(), u_i_map, nu(), u_i);
+  std::vector<double> u_i(nu());
+  _u_flat_index_map->fill_vector_from_map(u_i_map, u_i.data());
   return initialize_control_values(u_i);
 }
 
+int AcadosSolver::initialize_control_values(NamedVector const & u_i)
+{
+  if (!is_named_vector_consistent(u_i, _u_flat_index_map)) {
+    _logger.log(
+      LogLevel::WARNING, "Failed to set u (all stages), the NamedVector layout is invalid!");
+    return 1;
+  }
+  u_i.to_values(_u_buffer.data());
+  return initialize_control_values(_u_buffer);
+}
+
 // ------------------------------------------
 // Runtime parameters
 // ------------------------------------------
@@ -509,9 +855,9 @@ int AcadosSolver::initialize_control_values(ValueMap const & u_i_map)
 int AcadosSolver::set_runtime_parameters(unsigned int stage, ValueVector & p_i)
 {
   if (p_i.size() != np()) {
-    std::cerr << "WARNING: Failed to set p_" << stage << "!"
-              << "A vector of length " << np() << " is expected (" << p_i.size() << " provided)." <<
-      std::endl;
+    _logger.log(LogLevel::WARNING,
+      "Failed to set p_%u! A vector of length %u is expected (%zu provided).",
+      stage, np(), static_cast<size_t>(p_i.size()));
     return 1;
   }
   if (stage > N()) {
@@ -527,12 +873,21 @@ int AcadosSolver::set_runtime_parameters(unsigned int stage, ValueMap const & p_
   if (!is_values_map_complete(p_index_map(), p_i_map)) {
     return 1;
   }
-  std::vector<double> p_i;
-  p_i.reserve(np());
-  fill_vector_from_map(p_index_map(), p_i_map, np(), p_i);
+  std::vector<double> p_i(np());
+  _p_flat_index_map->fill_vector_from_map(p_i_map, p_i.data());
   return set_runtime_parameters(stage, p_i);
 }
 
+int AcadosSolver::set_runtime_parameters(unsigned int stage, NamedVector const & p_i)
+{
+  if (!is_named_vector_consistent(p_i, _p_flat_index_map)) {
+    _logger.log(LogLevel::WARNING, "Failed to set p_%u, the NamedVector layout is invalid!", stage);
+    return 1;
+  }
+  p_i.to_values(_p_buffer.data());
+  return set_runtime_parameters(stage, _p_buffer);
+}
+
 int AcadosSolver::set_runtime_parameters(ValueVector & p_i)
 {
   // From 0 to N to also set terminal node parameters!
@@ -548,12 +903,69 @@ int AcadosSolver::set_runtime_parameters(ValueMap const & p_i_map)
   if (!is_values_map_complete(p_index_map(), p_i_map)) {
     return 1;
   }
-  std::vector<double> p_i;
-  p_i.reserve(np());
-  fill_vector_from_map(p_index_map(), p_i_map, np(), p_i);
+  std::vector<double> p_i(np());
+  _p_flat_index_map->fill_vector_from_map(p_i_map, p_i.data());
   return set_runtime_parameters(p_i);
 }
 
+int AcadosSolver::set_runtime_parameters(NamedVector const & p_i)
+{
+  if (!is_named_vector_consistent(p_i, _p_flat_index_map)) {
+    _logger.log(
+      LogLevel::WARNING, "Failed to set p (all stages), the NamedVector layout is invalid!");
+    return 1;
+  }
+  p_i.to_values(_p_buffer.data());
+  return set_runtime_parameters(_p_buffer);
+}
+
+int AcadosSolver::set_runtime_parameters_trajectory(ColumnMajorXd const & p_traj)
+{
+  if (p_traj.rows() != np() || p_traj.cols() != N() + 1) {
+    _logger.log(LogLevel::WARNING,
+      "Failed to set the parameters trajectory! "
+      "A matrix of size %ux%u is expected (%ldx%ld provided).",
+      np(), N() + 1, static_cast<long>(p_traj.rows()), static_cast<long>(p_traj.cols()));
+    return 1;
+  }
+  int status = 0;
+  for (unsigned int stage = 0; stage <= N(); stage++) {
+    status += internal_update_params(
+      stage, const_cast<double *>(p_traj.col(stage).data()), np());
+  }
+  return status;
+}
+
+int AcadosSolver::set_runtime_parameters_trajectory(
+  std::string const & key,
+  ColumnMajorXd const & values_traj)
+{
+  auto it = _p_sparse_indexes.find(key);
+  if (it == _p_sparse_indexes.end()) {
+    _logger.log(LogLevel::WARNING,
+      "Failed to set the parameters trajectory, key '%s' not found!", key.c_str());
+    return 1;
+  }
+  std::vector<int> & sparse_idx = it->second;
+  if (values_traj.rows() != static_cast<Eigen::Index>(sparse_idx.size()) ||
+    values_traj.cols() != N() + 1)
+  {
+    _logger.log(LogLevel::WARNING,
+      "Failed to set the parameters trajectory of '%s'! "
+      "A matrix of size %zux%u is expected (%ldx%ld provided).",
+      key.c_str(), sparse_idx.size(), N() + 1,
+      static_cast<long>(values_traj.rows()), static_cast<long>(values_traj.cols()));
+    return 1;
+  }
+  int status = 0;
+  for (unsigned int stage = 0; stage <= N(); stage++) {
+    status += internal_update_params_sparse(
+      stage, sparse_idx.data(), const_cast<double *>(values_traj.col(stage).data()),
+      static_cast<int>(sparse_idx.size()));
+  }
+  return status;
+}
+
 
 //####################################################
 //                     GETTERS
@@ -566,13 +978,31 @@ ValueVector AcadosSolver::get_state_values(unsigned int stage)
     throw std::range_error(err_msg);
   }
   std::vector<double> x_i(nx(), 0.0);
-  ocp_nlp_out_get(get_nlp_config(), get_nlp_dims(), get_nlp_out(), stage, "x", x_i.data());
+  ocp_nlp_out_get(_nlp_config, _nlp_dims, _nlp_out, stage, "x", x_i.data());
   return x_i;
 }
 
 ValueMap AcadosSolver::get_state_values_as_map(unsigned int stage)
 {
-  return create_map_from_values(x_index_map(), get_state_values(stage));
+  ValueMap values_map;
+  _x_flat_index_map->fill_map_from_values(get_state_values(stage).data(), values_map);
+  return values_map;
+}
+
+void AcadosSolver::get_state_values_as_map(unsigned int stage, NamedVector & values)
+{
+  if (stage > N()) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::get_state_values_as_map()': Invalid stage request!";
+    throw std::range_error(err_msg);
+  }
+  if (!is_named_vector_consistent(values, _x_flat_index_map)) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::get_state_values_as_map()': Invalid NamedVector layout!";
+    throw std::invalid_argument(err_msg);
+  }
+  ocp_nlp_out_get(_nlp_config, _nlp_dims, _nlp_out, stage, "x", _x_buffer.data());
+  values.from_values(_x_buffer.data());
 }
 
 ValueVector AcadosSolver::get_algebraic_state_values(unsigned int stage)
@@ -583,12 +1013,30 @@ ValueVector AcadosSolver::get_algebraic_state_values(unsigned int stage)
     throw std::range_error(err_msg);
   }
   std::vector<double> z_i(nz(), 0.0);
-  ocp_nlp_out_get(get_nlp_config(), get_nlp_dims(), get_nlp_out(), stage, "z", z_i.data());
+  ocp_nlp_out_get(_nlp_config, _nlp_dims, _nlp_out, stage, "z", z_i.data());
   return z_i;
 }
 ValueMap AcadosSolver::get_algebraic_state_values_as_map(unsigned int stage)
 {
-  return create_map_from_values(z_index_map(), get_algebraic_state_values(stage));
+  ValueMap values_map;
+  _z_flat_index_map->fill_map_from_values(get_algebraic_state_values(stage).data(), values_map);
+  return values_map;
+}
+
+void AcadosSolver::get_algebraic_state_values_as_map(unsigned int stage, NamedVector & values)
+{
+  if (stage >= N()) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::get_algebraic_state_values_as_map()': Invalid stage request!";
+    throw std::range_error(err_msg);
+  }
+  if (!is_named_vector_consistent(values, _z_flat_index_map)) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::get_algebraic_state_values_as_map()': Invalid NamedVector layout!";
+    throw std::invalid_argument(err_msg);
+  }
+  ocp_nlp_out_get(_nlp_config, _nlp_dims, _nlp_out, stage, "z", _z_buffer.data());
+  values.from_values(_z_buffer.data());
 }
 
 ValueVector AcadosSolver::get_control_values(unsigned int stage)
@@ -598,12 +1046,30 @@ ValueVector AcadosSolver::get_control_values(unsigned int stage)
     throw std::range_error(err_msg);
   }
   std::vector<double> u_i(nu(), 0.0);
-  ocp_nlp_out_get(get_nlp_config(), get_nlp_dims(), get_nlp_out(), stage, "u", u_i.data());
+  ocp_nlp_out_get(_nlp_config, _nlp_dims, _nlp_out, stage, "u", u_i.data());
   return u_i;
 }
 ValueMap AcadosSolver::get_control_values_as_map(unsigned int stage)
 {
-  return create_map_from_values(u_index_map(), get_control_values(stage));
+  ValueMap values_map;
+  _u_flat_index_map->fill_map_from_values(get_control_values(stage).data(), values_map);
+  return values_map;
+}
+
+void AcadosSolver::get_control_values_as_map(unsigned int stage, NamedVector & values)
+{
+  if (stage >= N()) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::get_control_values_as_map()': Invalid stage request!";
+    throw std::range_error(err_msg);
+  }
+  if (!is_named_vector_consistent(values, _u_flat_index_map)) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::get_control_values_as_map()': Invalid NamedVector layout!";
+    throw std::invalid_argument(err_msg);
+  }
+  ocp_nlp_out_get(_nlp_config, _nlp_dims, _nlp_out, stage, "u", _u_buffer.data());
+  values.from_values(_u_buffer.data());
 }
 
 ValueVector AcadosSolver::get_parameter_values(unsigned int stage)
@@ -613,15 +1079,306 @@ ValueVector AcadosSolver::get_parameter_values(unsigned int stage)
     throw std::range_error(err_msg);
   }
   std::vector<double> p_i(np(), 0.0);
-  ocp_nlp_in_get(get_nlp_config(), get_nlp_dims(), get_nlp_in(), stage, "p", p_i.data());
+  ocp_nlp_in_get(_nlp_config, _nlp_dims, _nlp_in, stage, "p", p_i.data());
   return p_i;
 }
 
 ValueMap AcadosSolver::get_parameter_values_as_map(unsigned int stage)
 {
-  return create_map_from_values(p_index_map(), get_parameter_values(stage));
+  ValueMap values_map;
+  _p_flat_index_map->fill_map_from_values(get_parameter_values(stage).data(), values_map);
+  return values_map;
+}
+
+void AcadosSolver::get_parameter_values_as_map(unsigned int stage, NamedVector & values)
+{
+  if (stage > N()) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::get_parameter_values_as_map()': Invalid stage request!";
+    throw std::range_error(err_msg);
+  }
+  if (!is_named_vector_consistent(values, _p_flat_index_map)) {
+    std::string err_msg =
+      "Error in 'AcadosSolver::get_parameter_values_as_map()': Invalid NamedVector layout!";
+    throw std::invalid_argument(err_msg);
+  }
+  ocp_nlp_in_get(_nlp_config, _nlp_dims, _nlp_in, stage, "p", _p_buffer.data());
+  values.from_values(_p_buffer.data());
+}
+
+//####################################################
+//                UNCHECKED API
+//####################################################
+
+void AcadosSolver::set_initial_state_values_unchecked(const double * x_0) noexcept
+{
+  assert(_nlp_in != nullptr && x_0 != nullptr);
+  assert(_idxbx_0.size() == dims().nbx_0);
+  ocp_nlp_constraints_model_set(
+    _nlp_config, _nlp_dims, _nlp_in, _nlp_out, 0, "idxbx", _idxbx_0.data());
+  ocp_nlp_constraints_model_set(
+    _nlp_config, _nlp_dims, _nlp_in, _nlp_out, 0, "lbx", const_cast<double *>(x_0));
+  ocp_nlp_constraints_model_set(
+    _nlp_config, _nlp_dims, _nlp_in, _nlp_out, 0, "ubx", const_cast<double *>(x_0));
+  if (_lbx_cache.cols() > 0) {
+    _lbx_cache.col(0).setConstant(std::numeric_limits<double>::quiet_NaN());
+  }
+}
+
+void AcadosSolver::set_state_bounds_unchecked(
+  unsigned int stage,
+  const double * lbx,
+  const double * ubx) noexcept
+{
+  assert(_nlp_in != nullptr && stage <= _N);
+  ocp_nlp_constraints_model_set(
+    _nlp_config, _nlp_dims, _nlp_in, _nlp_out, stage, "lbx", const_cast<double *>(lbx));
+  ocp_nlp_constraints_model_set(
+    _nlp_config, _nlp_dims, _nlp_in, _nlp_out, stage, "ubx", const_cast<double *>(ubx));
+  if (stage < _lbx_cache.cols()) {
+    _lbx_cache.col(stage).setConstant(std::numeric_limits<double>::quiet_NaN());
+  }
+}
+
+void AcadosSolver::set_control_bounds_unchecked(
+  unsigned int stage,
+  const double * lbu,
+  const double * ubu) noexcept
+{
+  assert(_nlp_in != nullptr && stage < _N);
+  ocp_nlp_constraints_model_set(
+    _nlp_config, _nlp_dims, _nlp_in, _nlp_out, stage, "lbu", const_cast<double *>(lbu));
+  ocp_nlp_constraints_model_set(
+    _nlp_config, _nlp_dims, _nlp_in, _nlp_out, stage, "ubu", const_cast<double *>(ubu));
+  if (stage < _lbu_cache.cols()) {
+    _lbu_cache.col(stage).setConstant(std::numeric_limits<double>::quiet_NaN());
+  }
+}
+
+void AcadosSolver::set_runtime_parameters_unchecked(unsigned int stage, const double * p_i) noexcept
+{
+  assert(_nlp_in != nullptr && stage <= _N);
+  internal_update_params(stage, const_cast<double *>(p_i), np());
+}
+
+void AcadosSolver::initialize_state_values_unchecked(
+  unsigned int stage,
+  const double * x_i) noexcept
+{
+  assert(_nlp_out != nullptr && stage <= _N);
+  ocp_nlp_out_set(_nlp_config, _nlp_dims, _nlp_out, _nlp_in, stage, "x", const_cast<double *>(x_i));
+}
+
+void AcadosSolver::initialize_control_values_unchecked(
+  unsigned int stage,
+  const double * u_i) noexcept
+{
+  assert(_nlp_out != nullptr && stage < _N);
+  ocp_nlp_out_set(_nlp_config, _nlp_dims, _nlp_out, _nlp_in, stage, "u", const_cast<double *>(u_i));
+}
+
+void AcadosSolver::get_state_values_unchecked(unsigned int stage, double * x_i) const noexcept
+{
+  assert(_nlp_out != nullptr && stage <= _N);
+  ocp_nlp_out_get(_nlp_config, _nlp_dims, _nlp_out, stage, "x", x_i);
+}
+
+void AcadosSolver::get_algebraic_state_values_unchecked(
+  unsigned int stage,
+  double * z_i) const noexcept
+{
+  assert(_nlp_out != nullptr && stage < _N);
+  ocp_nlp_out_get(_nlp_config, _nlp_dims, _nlp_out, stage, "z", z_i);
+}
+
+void AcadosSolver::get_control_values_unchecked(unsigned int stage, double * u_i) const noexcept
+{
+  assert(_nlp_out != nullptr && stage < _N);
+  ocp_nlp_out_get(_nlp_config, _nlp_dims, _nlp_out, stage, "u", u_i);
+}
+
+void AcadosSolver::get_parameter_values_unchecked(unsigned int stage, double * p_i) const noexcept
+{
+  assert(_nlp_in != nullptr && stage <= _N);
+  ocp_nlp_in_get(_nlp_config, _nlp_dims, _nlp_in, stage, "p", p_i);
 }
 
+int AcadosSolver::simulate_unchecked(
+  double dt,
+  const double * x0,
+  const double * u0,
+  const double * p,
+  double * x_next,
+  double * z) noexcept
+{
+  assert(dt > 0.0 && x0 != nullptr && u0 != nullptr && x_next != nullptr);
+  return internal_simulate(
+    dt, const_cast<double *>(x0), const_cast<double *>(u0), const_cast<double *>(p), x_next, z);
+}
+
+//####################################################
+//                PRIMAL-DUAL ITERATE
+//####################################################
+
+int AcadosSolver::create_iterate(Iterate & iterate) const
+{
+  auto allocate_field = [this](
+    const char * field, unsigned int n_stages, std::vector<Eigen::VectorXd> & buffers) {
+      buffers.resize(n_stages);
+      for (unsigned int stage = 0; stage < n_stages; stage++) {
+        int dim = ocp_nlp_dims_get_from_attr(
+          _nlp_config, _nlp_dims, _nlp_out, stage, field);
+        buffers[stage].setZero(dim);
+      }
+    };
+  allocate_field("x", N() + 1, iterate.x);
+  allocate_field("u", N() + 1, iterate.u);
+  allocate_field("z", N() + 1, iterate.z);
+  allocate_field("pi", N(), iterate.pi);
+  allocate_field("lam", N() + 1, iterate.lam);
+  allocate_field("sl", N() + 1, iterate.sl);
+  allocate_field("su", N() + 1, iterate.su);
+  return 0;
+}
+
+int AcadosSolver::get_iterate(Iterate & iterate) const
+{
+  if (!is_iterate_consistent(iterate)) {
+    _logger.log(LogLevel::ERROR,
+      "Error in 'AcadosSolver::get_iterate()': "
+      "the iterate was not allocated with 'create_iterate()' (inconsistent stages or dimensions)!");
+    return 1;
+  }
+  auto get_field = [this](const char * field, std::vector<Eigen::VectorXd> & buffers) {
+      for (unsigned int stage = 0; stage < buffers.size(); stage++) {
+        if (buffers[stage].size() > 0) {
+          ocp_nlp_out_get(
+            _nlp_config, _nlp_dims, _nlp_out, stage, field, buffers[stage].data());
+        }
+      }
+    };
+  get_field("x", iterate.x);
+  get_field("u", iterate.u);
+  get_field("z", iterate.z);
+  get_field("pi", iterate.pi);
+  get_field("lam", iterate.lam);
+  get_field("sl", iterate.sl);
+  get_field("su", iterate.su);
+  return 0;
+}
+
+int AcadosSolver::set_iterate(Iterate const & iterate)
+{
+  if (!is_iterate_consistent(iterate)) {
+    _logger.log(LogLevel::ERROR,
+      "Error in 'AcadosSolver::set_iterate()': "
+      "the iterate was not allocated with 'create_iterate()' (inconsistent stages or dimensions)!");
+    return 1;
+  }
+  auto set_field = [this](const char * field, std::vector<Eigen::VectorXd> const & buffers) {
+      for (unsigned int stage = 0; stage < buffers.size(); stage++) {
+        if (buffers[stage].size() > 0) {
+          ocp_nlp_out_set(
+            _nlp_config, _nlp_dims, _nlp_out, _nlp_in,
+            stage, field, const_cast<double *>(buffers[stage].data()));
+        }
+      }
+    };
+  set_field("x", iterate.x);
+  set_field("u", iterate.u);
+  set_field("z", iterate.z);
+  set_field("pi", iterate.pi);
+  set_field("lam", iterate.lam);
+  set_field("sl", iterate.sl);
+  set_field("su", iterate.su);
+  return 0;
+}
+
+bool AcadosSolver::is_iterate_consistent(Iterate const & iterate) const
+{
+  auto is_field_consistent = [this](
+    const char * field, unsigned int n_stages, std::vector<Eigen::VectorXd> const & buffers) {
+      if (buffers.size() != n_stages) {
+        return false;
+      }
+      for (unsigned int stage = 0; stage < n_stages; stage++) {
+        int dim = ocp_nlp_dims_get_from_attr(
+          _nlp_config, _nlp_dims, _nlp_out, stage, field);
+        if (buffers[stage].size() != dim) {
+          return false;
+        }
+      }
+      return true;
+    };
+  return is_field_consistent("x", N() + 1, iterate.x) &&
+         is_field_consistent("u", N() + 1, iterate.u) &&
+         is_field_consistent("z", N() + 1, iterate.z) &&
+         is_field_consistent("pi", N(), iterate.pi) &&
+         is_field_consistent("lam", N() + 1, iterate.lam) &&
+         is_field_consistent("sl", N() + 1, iterate.sl) &&
+         is_field_consistent("su", N() + 1, iterate.su);
+}
+
+//####################################################
+//                LINEAR FEEDBACK
+//####################################################
+
+int AcadosSolver::update_linear_feedback()
+{
+  if (_feedback_gain.rows() != nu() || _feedback_gain.cols() != nx()) {
+    _logger.log(LogLevel::ERROR,
+      "Error in 'AcadosSolver::update_linear_feedback()': the solver is not initialized!");
+    return 1;
+  }
+  // Linearization point
+  ocp_nlp_out_get(
+    _nlp_config, _nlp_dims, _nlp_out, 0, "x", _feedback_x0.data());
+  ocp_nlp_out_get(
+    _nlp_config, _nlp_dims, _nlp_out, 0, "u", _feedback_u0.data());
+
+  // Sensitivity of u_0 w.r.t. each component of the initial state x_0
+  char field[] = "ex";
+  for (unsigned int idx = 0; idx < nx(); idx++) {
+    ocp_nlp_eval_param_sens(_nlp_solver, field, 0, idx, _sens_out);
+    ocp_nlp_out_get(
+      _nlp_config, _nlp_dims, _sens_out, 0, "u", _feedback_gain.col(idx).data());
+  }
+  return 0;
+}
+
+int AcadosSolver::evaluate_linear_feedback(
+  Eigen::Ref<const Eigen::VectorXd> x,
+  Eigen::Ref<Eigen::VectorXd> u) const
+{
+  if (x.size() != _feedback_x0.size() || u.size() != _feedback_u0.size()) {
+    return 1;
+  }
+  // Two products with plain operands so that Eigen does not allocate temporaries
+  u = _feedback_u0;
+  u.noalias() -= _feedback_gain * _feedback_x0;
+  u.noalias() += _feedback_gain * x;
+  return 0;
+}
+
+int AcadosSolver::evaluate_linear_feedback(ValueVector const & x, ValueVector & u) const
+{
+  if (x.size() != nx() || u.size() != nu()) {
+    return 1;
+  }
+  return evaluate_linear_feedback(
+    Eigen::Map<const Eigen::VectorXd>(x.data(), x.size()),
+    Eigen::Map<Eigen::VectorXd>(u.data(), u.size()));
+}
+
+const ColumnMajorXd & AcadosSolver::linear_feedback_gain() const
+{
+  return _feedback_gain;
+}
+
+//####################################################
+//                INDEX MAPS
+//####################################################
+
 const IndexMap & AcadosSolver::x_index_map() const
 {
   return _x_index_map;
@@ -638,6 +1395,44 @@ const IndexMap & AcadosSolver::u_index_map() const
 {
   return _u_index_map;
 }
+const FlatIndexMap & AcadosSolver::x_flat_index_map() const
+{
+  return *_x_flat_index_map;
+}
+const FlatIndexMap & AcadosSolver::z_flat_index_map() const
+{
+  return *_z_flat_index_map;
+}
+const FlatIndexMap & AcadosSolver::p_flat_index_map() const
+{
+  return *_p_flat_index_map;
+}
+const FlatIndexMap & AcadosSolver::u_flat_index_map() const
+{
+  return *_u_flat_index_map;
+}
+NamedVector AcadosSolver::x_named_vector() const
+{
+  return NamedVector(_x_flat_index_map);
+}
+NamedVector AcadosSolver::z_named_vector() const
+{
+  return NamedVector(_z_flat_index_map);
+}
+NamedVector AcadosSolver::p_named_vector() const
+{
+  return NamedVector(_p_flat_index_map);
+}
+NamedVector AcadosSolver::u_named_vector() const
+{
+  return NamedVector(_u_flat_index_map);
+}
+bool AcadosSolver::is_named_vector_consistent(
+  NamedVector const & values,
+  std::shared_ptr<FlatIndexMap> const & layout) const
+{
+  return values.layout() == layout;
+}
 
 
 //####################################################
@@ -669,13 +1464,14 @@ bool AcadosSolver::is_values_map_complete(
   bool all_ok = true;
   for (const auto & [key, indexes] : index_map) {
     if (values_map.find(key) == values_map.end()) {
-      std::cerr << "key '" << key << "' not found!" << std::endl;
+      Logger::default_logger().log(LogLevel::WARNING, "key '%s' not found!", key.c_str());
       all_ok = false;
       break;
     }
     all_ok &= (indexes.size() == values_map.at(key).size());
     if (!all_ok) {
-      std::cerr << "key '" << key << "' has values of incorrect size!" << std::endl;
+      Logger::default_logger().log(
+        LogLevel::WARNING, "key '%s' has values of incorrect size!", key.c_str());
     }
     if (!all_ok) {
       break;
@@ -700,7 +1496,7 @@ void AcadosSolver::fill_vector_from_map(
   }
   // Fill the vector
   for (const auto & [key, indexes] : index_map) {
-    std::vector<double> input_values = values_map.at(key);
+    const ValueVector & input_values = values_map.at(key);
     for (unsigned int i = 0; i < indexes.size(); i++) {
       values[indexes[i]] = input_values[i];
     }
@@ -755,11 +1551,11 @@ void AcadosSolver::fill_map_from_values(
   // Note: this will overwrite existing keys in value_map
   //       that are also in index_map.
   for (const auto & [key, indexes] : index_map) {
-    std::vector<double> tmp_data(indexes.size(), 0.0);
+    ValueVector & key_values = value_map[key];
+    key_values.resize(indexes.size());
     for (unsigned int i = 0; i < indexes.size(); i++) {
-      tmp_data[i] = values[indexes[i]];
+      key_values[i] = values[indexes[i]];
     }
-    value_map[key] = tmp_data;
   }
 }
 
@@ -773,12 +1569,12 @@ const AcadosSolver::Dimensions & AcadosSolver::dims() const
 }
 unsigned int AcadosSolver::nx() const
 {
-  // return *(get_nlp_dims()->nx);
+  // return *(_nlp_dims->nx);
   return dims().nx;
 }
 unsigned int AcadosSolver::nz() const
 {
-  // return *(get_nlp_dims()->nz);
+  // return *(_nlp_dims->nz);
   return dims().nz;
 }
 unsigned int AcadosSolver::np() const
@@ -788,12 +1584,12 @@ unsigned int AcadosSolver::np() const
 }
 unsigned int AcadosSolver::nu() const
 {
-  // return *(get_nlp_dims()->nu);
+  // return *(_nlp_dims->nu);
   return dims().nu;
 }
 unsigned int AcadosSolver::N() const
 {
-  return get_nlp_dims()->N;
+  return _N;
 }
 double AcadosSolver::Ts() const
 {
@@ -802,8 +1598,13 @@ double AcadosSolver::Ts() const
 ValueVector AcadosSolver::sampling_intervals() const
 {
   std::vector<double> sampling_intervals_vect;
-  sampling_intervals_vect.assign(get_nlp_in()->Ts, get_nlp_in()->Ts + N());
+  sampling_intervals_vect.assign(_nlp_in->Ts, _nlp_in->Ts + N());
   return sampling_intervals_vect;
 }
 
+Logger & AcadosSolver::logger()
+{
+  return _logger;
+}
+
 }  // namespace acados
@@ -0,0 +1,188 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_solver_base/acados_solver_logging.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+
+namespace acados
+{
+
+namespace
+{
+int64_t steady_clock_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char * level_to_string(LogLevel level)
+{
+  switch (level) {
+    case LogLevel::DEBUG:
+      return "DEBUG";
+    case LogLevel::INFO:
+      return "INFO";
+    case LogLevel::WARNING:
+      return "WARNING";
+    case LogLevel::ERROR:
+      return "ERROR";
+  }
+  return "UNKNOWN";
+}
+}  // namespace
+
+//####################################################
+//                   STREAMLOGSINK
+//####################################################
+
+void StreamLogSink::write(LogRecord const & record)
+{
+  std::ostream & stream = (record.level >= LogLevel::WARNING) ? std::cerr : std::cout;
+  stream << "[acados_solver][" << level_to_string(record.level) << "] " << record.message << std::endl;
+}
+
+//####################################################
+//                    ASYNCLOGSINK
+//####################################################
+
+AsyncLogSink::AsyncLogSink(
+  std::shared_ptr<LogSink> downstream_sink,
+  size_t capacity,
+  std::chrono::milliseconds polling_period)
+: _downstream_sink(downstream_sink),
+  _queue(capacity),
+  _polling_period(polling_period)
+{
+  _thread = std::thread(
+    [this]() {
+      while (_running.load(std::memory_order_acquire)) {
+        drain();
+        std::this_thread::sleep_for(_polling_period);
+      }
+      drain();
+    });
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+  _running.store(false, std::memory_order_release);
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+void AsyncLogSink::write(LogRecord const & record)
+{
+  if (!_queue.try_push(record)) {
+    _dropped_records.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+uint64_t AsyncLogSink::dropped_records() const
+{
+  return _dropped_records.load(std::memory_order_relaxed);
+}
+
+void AsyncLogSink::drain()
+{
+  LogRecord record;
+  while (_queue.try_pop(record)) {
+    if (_downstream_sink) {
+      _downstream_sink->write(record);
+    }
+  }
+}
+
+//####################################################
+//                       LOGGER
+//####################################################
+
+Logger::Logger()
+{
+  static std::shared_ptr<LogSink> default_sink = std::make_shared<StreamLogSink>();
+  _sink = default_sink;
+}
+
+void Logger::set_sink(std::shared_ptr<LogSink> sink)
+{
+  _sink = sink;
+}
+
+std::shared_ptr<LogSink> Logger::sink() const
+{
+  return _sink;
+}
+
+void Logger::set_rate_limit(std::chrono::nanoseconds min_interval)
+{
+  _min_interval_ns.store(min_interval.count(), std::memory_order_relaxed);
+}
+
+void Logger::set_level(LogLevel level)
+{
+  _level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Logger::log(LogLevel level, const char * format, ...) const
+{
+  if (static_cast<int>(level) < _level.load(std::memory_order_relaxed) || !_sink) {
+    return;
+  }
+  LogRecord record;
+  record.level = level;
+  record.stamp_ns = steady_clock_ns();
+
+  // Rate limiting (per call site)
+  uint32_t suppressed = 0;
+  const int64_t min_interval_ns = _min_interval_ns.load(std::memory_order_relaxed);
+  if (min_interval_ns > 0) {
+    RateLimitSlot & slot = _slots[std::hash<const void *>{}(format) % RATE_LIMIT_SLOTS];
+    int64_t last_emission_ns = slot.last_emission_ns.load(std::memory_order_relaxed);
+    if (
+      (last_emission_ns != std::numeric_limits<int64_t>::min() &&
+      record.stamp_ns - last_emission_ns < min_interval_ns) ||
+      !slot.last_emission_ns.compare_exchange_strong(last_emission_ns, record.stamp_ns))
+    {
+      slot.suppressed.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    suppressed = slot.suppressed.exchange(0, std::memory_order_relaxed);
+  }
+
+  // Format message
+  va_list args;
+  va_start(args, format);
+  int length = std::vsnprintf(record.message, LogRecord::MAX_MESSAGE_LENGTH, format, args);
+  va_end(args);
+  if (suppressed > 0 && length >= 0 && static_cast<size_t>(length) < LogRecord::MAX_MESSAGE_LENGTH) {
+    std::snprintf(
+      record.message + length, LogRecord::MAX_MESSAGE_LENGTH - length,
+      " (%u similar messages suppressed)", static_cast<unsigned int>(suppressed));
+  }
+  _sink->write(record);
+}
+
+Logger & Logger::default_logger()
+{
+  static Logger logger;
+  return logger;
+}
+
+}  // namespace acados
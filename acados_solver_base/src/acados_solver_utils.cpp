@@ -257,4 +257,55 @@ double utils::get_stats_cpu_time(AcadosSolver & solver)
   return time_tot;
 }
 
+// ------------------------------------------------------------
+// Warm start
+// ------------------------------------------------------------
+
+bool utils::shift_warm_start(
+  AcadosSolver & solver,
+  double elapsed_time,
+  TrajectoryInterpolator & interpolator)
+{
+  if (!(elapsed_time >= 0.0)) {
+    throw std::invalid_argument(
+            "Acados::utils::shift_warm_start: the elapsed time must be non-negative!");
+  }
+  if (interpolator.update(solver) != 0) {
+    return false;
+  }
+  // Scratch buffers of the calling thread (only reallocated if the dimensions change)
+  thread_local Eigen::VectorXd x_i, u_i;
+  x_i.resize(solver.nx());
+  u_i.resize(solver.nu());
+  return shift_warm_start(solver, elapsed_time, interpolator, x_i, u_i);
+}
+
+bool utils::shift_warm_start(
+  AcadosSolver & solver,
+  double elapsed_time,
+  TrajectoryInterpolator const & interpolator,
+  Eigen::Ref<Eigen::VectorXd> x_buffer,
+  Eigen::Ref<Eigen::VectorXd> u_buffer)
+{
+  if (!(elapsed_time >= 0.0)) {
+    throw std::invalid_argument(
+            "Acados::utils::shift_warm_start: the elapsed time must be non-negative!");
+  }
+  if (!interpolator.is_ready() || x_buffer.size() != solver.nx() ||
+    u_buffer.size() != solver.nu())
+  {
+    return false;
+  }
+  for (unsigned int stage = 0; stage <= solver.N(); stage++) {
+    const double t_i = interpolator.node_time(stage) + elapsed_time;
+    interpolator.evaluate_state(t_i, x_buffer);
+    solver.initialize_state_values_unchecked(stage, x_buffer.data());
+    if (stage < solver.N()) {
+      interpolator.evaluate_control(t_i, u_buffer);
+      solver.initialize_control_values_unchecked(stage, u_buffer.data());
+    }
+  }
+  return true;
+}
+
 }  // namespace acados
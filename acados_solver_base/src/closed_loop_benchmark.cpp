@@ -0,0 +1,295 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_solver_base/closed_loop_benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace acados
+{
+
+namespace
+{
+
+/// @brief Write the entries of a (possibly partial) value map into a dense vector.
+void fill_dense_from_map(
+  IndexMap const & index_map,
+  ValueMap const & values_map,
+  std::string const & option_name,
+  Eigen::VectorXd & values)
+{
+  for (auto const & [key, key_values] : values_map) {
+    auto it = index_map.find(key);
+    if (it == index_map.end() || it->second.size() != key_values.size()) {
+      throw std::invalid_argument(
+              "Error in 'ClosedLoopBenchmark::ClosedLoopBenchmark()': "
+              "missing key or invalid size for key '" + key + "' of '" + option_name + "'!");
+    }
+    for (size_t i = 0; i < key_values.size(); i++) {
+      values[it->second[i]] = key_values[i];
+    }
+  }
+}
+
+/// @brief Returns the column names of a vector ("key" or "key_i" if the key has several indexes).
+std::vector<std::string> column_names(IndexMap const & index_map, unsigned int size)
+{
+  std::vector<std::string> names(size);
+  for (auto const & [key, indexes] : index_map) {
+    for (size_t i = 0; i < indexes.size(); i++) {
+      names[indexes[i]] = (indexes.size() == 1) ? key : key + "_" + std::to_string(i);
+    }
+  }
+  return names;
+}
+
+/// @brief Nearest-rank percentile of sorted values.
+double percentile(std::vector<double> const & sorted_values, double percent)
+{
+  const size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * sorted_values.size()));
+  return sorted_values[std::min(std::max<size_t>(rank, 1), sorted_values.size()) - 1];
+}
+
+}  // namespace
+
+ClosedLoopBenchmark::ClosedLoopBenchmark(AcadosSolver & solver, Options const & options)
+: _solver(solver),
+  _num_steps(options.num_steps),
+  _deadline((options.deadline > 0.0) ? options.deadline : solver.Ts()),
+  _use_rti(options.use_rti)
+{
+  if (_solver.N() == 0 || _solver.nx() == 0) {
+    throw std::invalid_argument(
+            "Error in 'ClosedLoopBenchmark::ClosedLoopBenchmark()': "
+            "the solver is not initialized!");
+  }
+  if (options.deadline < 0.0) {
+    throw std::invalid_argument(
+            "Error in 'ClosedLoopBenchmark::ClosedLoopBenchmark()': "
+            "the deadline must be positive!");
+  }
+  // Initial state and parameters (complete maps, see `AcadosSolver::fill_vector_from_map()`)
+  AcadosSolver::fill_vector_from_map(_solver.x_index_map(), options.x0, _solver.nx(), _x0);
+  if (_solver.np() > 0) {
+    AcadosSolver::fill_vector_from_map(_solver.p_index_map(), options.p, _solver.np(), _p);
+  }
+
+  // Tracking cost
+  _x_ref = Eigen::VectorXd::Zero(_solver.nx());
+  _x_weights = Eigen::VectorXd::Zero(_solver.nx());
+  _u_weights = Eigen::VectorXd::Zero(_solver.nu());
+  fill_dense_from_map(_solver.x_index_map(), options.x_ref, "x_ref", _x_ref);
+  for (auto const & [key, key_values] : options.x_ref) {
+    ValueMap default_weights = {{key, ValueVector(key_values.size(), 1.0)}};
+    fill_dense_from_map(_solver.x_index_map(), default_weights, "x_ref", _x_weights);
+  }
+  fill_dense_from_map(_solver.x_index_map(), options.x_weights, "x_weights", _x_weights);
+  fill_dense_from_map(_solver.u_index_map(), options.u_weights, "u_weights", _u_weights);
+
+  // Preallocate the records
+  _records.resize(_num_steps);
+  for (StepRecord & record : _records) {
+    record.x.resize(_solver.nx());
+    record.u.resize(_solver.nu());
+  }
+}
+
+int ClosedLoopBenchmark::run()
+{
+  const double Ts = _solver.Ts();
+  ValueVector x = _x0;
+  ValueVector x_next(_solver.nx(), 0.0);
+  ValueVector z(_solver.nz(), 0.0);
+  if (_solver.np() > 0) {
+    _solver.set_runtime_parameters(_p);
+  }
+  if (_use_rti) {
+    _solver.solve_rti(RtiStage::PREPARATION);
+  }
+
+  int sim_status = 0;
+  size_t num_records = 0;
+  _records.resize(_num_steps);  // Shrunk if the previous run was aborted
+  for (unsigned int step = 0; step < _num_steps; step++) {
+    StepRecord & record = _records[step];
+    record.time = step * Ts;
+    record.x = x;
+    record.u.resize(_solver.nu());
+
+    // Solve
+    _solver.set_initial_state_values_unchecked(x.data());
+    const auto start_time = std::chrono::steady_clock::now();
+    record.status = _use_rti ? _solver.solve_rti(RtiStage::FEEDBACK) : _solver.solve();
+    record.solve_time =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    AcadosSolver::SolveStats const & stats = _solver.solve_stats();
+    record.time_tot = stats.time_tot;
+    record.sqp_iter = stats.sqp_iter;
+    record.qp_iter = stats.qp_iter;
+    record.deadline_missed = record.solve_time > _deadline;
+    _solver.get_control_values_unchecked(0, record.u.data());
+
+    // Tracking cost
+    const Eigen::Map<const Eigen::VectorXd> x_k(x.data(), x.size());
+    const Eigen::Map<const Eigen::VectorXd> u_k(record.u.data(), record.u.size());
+    record.stage_cost = (_x_weights.array() * (x_k - _x_ref).array().square()).sum() +
+      (_u_weights.array() * u_k.array().square()).sum();
+    num_records++;
+
+    // Plant
+    sim_status = _solver.simulate(Ts, x, record.u, _p, x_next, z);
+    if (sim_status != 0) {
+      break;
+    }
+    std::swap(x, x_next);
+    if (_use_rti) {
+      _solver.solve_rti(RtiStage::PREPARATION);
+    }
+  }
+  _records.resize(num_records);
+  compute_summary();
+  return sim_status;
+}
+
+const std::vector<ClosedLoopBenchmark::StepRecord> & ClosedLoopBenchmark::records() const
+{
+  return _records;
+}
+
+const ClosedLoopBenchmark::Summary & ClosedLoopBenchmark::summary() const
+{
+  return _summary;
+}
+
+void ClosedLoopBenchmark::compute_summary()
+{
+  _summary = Summary();
+  _summary.num_steps = _records.size();
+  if (_records.empty()) {
+    return;
+  }
+  std::vector<double> solve_times;
+  solve_times.reserve(_records.size());
+  for (StepRecord const & record : _records) {
+    solve_times.push_back(record.solve_time);
+    _summary.num_failures += (record.status != ACADOS_SUCCESS) ? 1 : 0;
+    _summary.num_deadline_misses += record.deadline_missed ? 1 : 0;
+    _summary.solve_time_mean += record.solve_time;
+    _summary.sqp_iter_mean += record.sqp_iter;
+    _summary.sqp_iter_max = std::max(_summary.sqp_iter_max, record.sqp_iter);
+    _summary.tracking_cost += record.stage_cost;
+  }
+  _summary.solve_time_mean /= _records.size();
+  _summary.sqp_iter_mean /= _records.size();
+  std::sort(solve_times.begin(), solve_times.end());
+  _summary.solve_time_min = solve_times.front();
+  _summary.solve_time_p50 = percentile(solve_times, 50.0);
+  _summary.solve_time_p95 = percentile(solve_times, 95.0);
+  _summary.solve_time_p99 = percentile(solve_times, 99.0);
+  _summary.solve_time_max = solve_times.back();
+}
+
+//####################################################################
+// Export
+//####################################################################
+
+void ClosedLoopBenchmark::write_csv(std::ostream & stream) const
+{
+  const std::vector<std::string> x_names = column_names(_solver.x_index_map(), _solver.nx());
+  const std::vector<std::string> u_names = column_names(_solver.u_index_map(), _solver.nu());
+  stream << "step,time,status,solve_time,time_tot,sqp_iter,qp_iter,deadline_missed,stage_cost";
+  for (auto const & name : x_names) {
+    stream << ",x_" << name;
+  }
+  for (auto const & name : u_names) {
+    stream << ",u_" << name;
+  }
+  stream << "\n";
+  const std::streamsize precision = stream.precision(10);  // Restored at the end
+  for (size_t step = 0; step < _records.size(); step++) {
+    StepRecord const & record = _records[step];
+    stream << step << "," << record.time << "," << record.status << "," << record.solve_time << "," <<
+      record.time_tot << "," << record.sqp_iter << "," << record.qp_iter << "," <<
+      (record.deadline_missed ? 1 : 0) << "," << record.stage_cost;
+    for (double value : record.x) {
+      stream << "," << value;
+    }
+    for (double value : record.u) {
+      stream << "," << value;
+    }
+    stream << "\n";
+  }
+  stream.precision(precision);
+}
+
+void ClosedLoopBenchmark::write_json(std::ostream & stream) const
+{
+  auto write_array = [&](const char * name, auto getter, bool last = false) {
+      stream << "    \"" << name << "\": [";
+      for (size_t step = 0; step < _records.size(); step++) {
+        stream << ((step > 0) ? ", " : "") << getter(_records[step]);
+      }
+      stream << "]" << (last ? "\n" : ",\n");
+    };
+
+  const std::streamsize precision = stream.precision(10);  // Restored at the end
+  stream << "{\n";
+  stream << "  \"summary\": {\n";
+  stream << "    \"num_steps\": " << _summary.num_steps << ",\n";
+  stream << "    \"num_failures\": " << _summary.num_failures << ",\n";
+  stream << "    \"num_deadline_misses\": " << _summary.num_deadline_misses << ",\n";
+  stream << "    \"deadline\": " << _deadline << ",\n";
+  stream << "    \"solve_time_min\": " << _summary.solve_time_min << ",\n";
+  stream << "    \"solve_time_mean\": " << _summary.solve_time_mean << ",\n";
+  stream << "    \"solve_time_p50\": " << _summary.solve_time_p50 << ",\n";
+  stream << "    \"solve_time_p95\": " << _summary.solve_time_p95 << ",\n";
+  stream << "    \"solve_time_p99\": " << _summary.solve_time_p99 << ",\n";
+  stream << "    \"solve_time_max\": " << _summary.solve_time_max << ",\n";
+  stream << "    \"sqp_iter_mean\": " << _summary.sqp_iter_mean << ",\n";
+  stream << "    \"sqp_iter_max\": " << _summary.sqp_iter_max << ",\n";
+  stream << "    \"tracking_cost\": " << _summary.tracking_cost << "\n";
+  stream << "  },\n";
+  // Effective runtime parameters (including the defaults of the keys missing from the options)
+  const std::vector<std::string> p_names = column_names(_solver.p_index_map(), _solver.np());
+  stream << "  \"parameters\": {";
+  for (size_t i = 0; i < _p.size(); i++) {
+    stream << ((i > 0) ? ", " : "") << "\"" << p_names[i] << "\": " << _p[i];
+  }
+  stream << "},\n";
+  stream << "  \"steps\": {\n";
+  write_array("time", [](StepRecord const & record) {return record.time;});
+  write_array("status", [](StepRecord const & record) {return record.status;});
+  write_array("solve_time", [](StepRecord const & record) {return record.solve_time;});
+  write_array("time_tot", [](StepRecord const & record) {return record.time_tot;});
+  write_array("sqp_iter", [](StepRecord const & record) {return record.sqp_iter;});
+  write_array("qp_iter", [](StepRecord const & record) {return record.qp_iter;});
+  write_array(
+    "deadline_missed", [](StepRecord const & record) {
+      return record.deadline_missed ? "true" : "false";
+    });
+  write_array("stage_cost", [](StepRecord const & record) {return record.stage_cost;}, true);
+  stream << "  }\n";
+  stream << "}\n";
+  stream.precision(precision);
+}
+
+}  // namespace acados
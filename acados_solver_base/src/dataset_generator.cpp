@@ -0,0 +1,368 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_solver_base/dataset_generator.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace acados
+{
+
+namespace
+{
+
+/// @brief Fill the dense sampling ranges from the (possibly partial) range maps.
+void fill_ranges(
+  IndexMap const & index_map,
+  ValueMap const & lower_map,
+  ValueMap const & upper_map,
+  std::string const & option_name,
+  Eigen::VectorXd & lower,
+  Eigen::VectorXd & upper)
+{
+  if (lower_map.size() != upper_map.size()) {
+    throw std::invalid_argument(
+            "Error in 'DatasetGenerator::DatasetGenerator()': "
+            "the lower and upper bounds of '" + option_name + "' must have the same keys!");
+  }
+  for (auto const & [key, lower_values] : lower_map) {
+    auto it = index_map.find(key);
+    auto upper_it = upper_map.find(key);
+    if (it == index_map.end() || upper_it == upper_map.end() ||
+      it->second.size() != lower_values.size() || it->second.size() != upper_it->second.size())
+    {
+      throw std::invalid_argument(
+              "Error in 'DatasetGenerator::DatasetGenerator()': "
+              "missing key or invalid size for key '" + key + "' of '" + option_name + "'!");
+    }
+    for (size_t i = 0; i < lower_values.size(); i++) {
+      if (lower_values[i] > upper_it->second[i]) {
+        throw std::invalid_argument(
+                "Error in 'DatasetGenerator::DatasetGenerator()': "
+                "empty range for key '" + key + "' of '" + option_name + "'!");
+      }
+      lower[it->second[i]] = lower_values[i];
+      upper[it->second[i]] = upper_it->second[i];
+    }
+  }
+}
+
+uint64_t align(uint64_t offset)
+{
+  return (offset + DATASET_ALIGNMENT - 1) / DATASET_ALIGNMENT * DATASET_ALIGNMENT;
+}
+
+}  // namespace
+
+//####################################################################
+// DatasetGenerator
+//####################################################################
+
+DatasetGenerator::DatasetGenerator(SolverFactory solver_factory, Options const & options)
+: _solver_factory(solver_factory),
+  _options(options)
+{
+  if (!_solver_factory) {
+    throw std::invalid_argument(
+            "Error in 'DatasetGenerator::DatasetGenerator()': invalid solver factory!");
+  }
+  _first_solver = _solver_factory();
+  if (!_first_solver || _first_solver->N() == 0 || _first_solver->nx() == 0) {
+    throw std::invalid_argument(
+            "Error in 'DatasetGenerator::DatasetGenerator()': "
+            "the solver factory must return initialized solvers!");
+  }
+  _nx = _first_solver->nx();
+  _nu = _first_solver->nu();
+  _np = _first_solver->np();
+  _N = _first_solver->N();
+
+  _x0_lower = Eigen::VectorXd::Zero(_nx);
+  _x0_upper = Eigen::VectorXd::Zero(_nx);
+  // The parameters without range keep the values set by the factory (stage 0)
+  _p_lower = Eigen::VectorXd::Zero(_np);
+  if (_np > 0) {
+    ValueVector p_default = _first_solver->get_parameter_values(0);
+    _p_lower = Eigen::Map<const Eigen::VectorXd>(p_default.data(), _np);
+  }
+  _p_upper = _p_lower;
+  fill_ranges(
+    _first_solver->x_index_map(), _options.x0_lower, _options.x0_upper, "x0", _x0_lower, _x0_upper);
+  fill_ranges(
+    _first_solver->p_index_map(), _options.p_lower, _options.p_upper, "p", _p_lower, _p_upper);
+}
+
+DatasetGenerator::Summary DatasetGenerator::generate(std::string const & path)
+{
+  const auto start_time = std::chrono::steady_clock::now();
+  const size_t num_samples = _options.num_samples;
+
+  // Columns
+  std::vector<std::pair<std::string, uint64_t>> columns = {{"x0", _nx}};
+  if (_np > 0) {
+    columns.push_back({"p", _np});
+  }
+  columns.insert(
+    columns.end(), {{"status", 1}, {"solve_time", 1}, {"sqp_iter", 1}, {"u0", _nu}});
+  if (_options.store_trajectories) {
+    columns.insert(columns.end(), {{"x_traj", (_N + 1) * _nx}, {"u_traj", _N * _nu}});
+  }
+  std::vector<uint64_t> offsets(columns.size());
+  uint64_t size = align(sizeof(DatasetFileHeader) + columns.size() * sizeof(DatasetColumnHeader));
+  for (size_t j = 0; j < columns.size(); j++) {
+    offsets[j] = size;
+    size = align(size + num_samples * columns[j].second * sizeof(double));
+  }
+
+  // Map the output file
+  int fd = open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+  if (fd < 0) {
+    throw std::runtime_error(
+            "Error in 'DatasetGenerator::generate()': failed to create '" + path + "'!");
+  }
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    close(fd);
+    throw std::runtime_error(
+            "Error in 'DatasetGenerator::generate()': ftruncate() failed for '" + path + "'!");
+  }
+  void * address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    throw std::runtime_error(
+            "Error in 'DatasetGenerator::generate()': mmap() failed for '" + path + "'!");
+  }
+  char * data = static_cast<char *>(address);
+
+  // Headers
+  DatasetFileHeader file_header;
+  std::memcpy(file_header.magic, DATASET_MAGIC, sizeof(DATASET_MAGIC));
+  file_header.version = DATASET_VERSION;
+  file_header.num_columns = static_cast<uint32_t>(columns.size());
+  file_header.num_samples = num_samples;
+  std::memcpy(data, &file_header, sizeof(file_header));
+  for (size_t j = 0; j < columns.size(); j++) {
+    DatasetColumnHeader column_header;
+    std::memset(&column_header, 0, sizeof(column_header));
+    std::strncpy(column_header.name, columns[j].first.c_str(), sizeof(column_header.name) - 1);
+    column_header.offset = offsets[j];
+    column_header.width = columns[j].second;
+    char * column_header_address = data + sizeof(file_header) + j * sizeof(column_header);
+    std::memcpy(column_header_address, &column_header, sizeof(column_header));
+  }
+  auto column_data = [&](std::string const & name) -> double * {
+      for (size_t j = 0; j < columns.size(); j++) {
+        if (columns[j].first == name) {
+          return reinterpret_cast<double *>(data + offsets[j]);
+        }
+      }
+      return nullptr;
+    };
+  _x0_data = column_data("x0");
+  _p_data = column_data("p");
+  _status_data = column_data("status");
+  _solve_time_data = column_data("solve_time");
+  _sqp_iter_data = column_data("sqp_iter");
+  _u0_data = column_data("u0");
+  _x_traj_data = column_data("x_traj");
+  _u_traj_data = column_data("u_traj");
+
+  // Sample the inputs (sequentially, so that the samples do not depend on the number of threads)
+  std::mt19937_64 generator(_options.seed);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  for (size_t i = 0; i < num_samples; i++) {
+    for (unsigned int k = 0; k < _nx; k++) {
+      _x0_data[i * _nx + k] =
+        _x0_lower[k] + (_x0_upper[k] - _x0_lower[k]) * distribution(generator);
+    }
+    for (unsigned int k = 0; k < _np; k++) {
+      _p_data[i * _np + k] = _p_lower[k] + (_p_upper[k] - _p_lower[k]) * distribution(generator);
+    }
+  }
+
+  // Solve in parallel (one solver instance and one contiguous chunk per worker)
+  unsigned int num_threads = (_options.num_threads > 0) ?
+    _options.num_threads : std::max(1u, std::thread::hardware_concurrency());
+  num_threads = static_cast<unsigned int>(
+    std::max<size_t>(1, std::min<size_t>(num_threads, num_samples)));
+  std::vector<std::shared_ptr<AcadosSolver>> solvers = {_first_solver};
+  while (solvers.size() < num_threads) {
+    solvers.push_back(_solver_factory());
+  }
+  std::vector<size_t> num_failures(num_threads, 0);
+  std::vector<std::thread> workers;
+  const size_t chunk_size = (num_samples + num_threads - 1) / num_threads;
+  for (unsigned int t = 0; t < num_threads; t++) {
+    const size_t begin = std::min(num_samples, t * chunk_size);
+    const size_t end = std::min(num_samples, begin + chunk_size);
+    workers.emplace_back(
+      [this, &solvers, &num_failures, t, begin, end]() {
+        solve_chunk(*solvers[t], begin, end, num_failures[t]);
+      });
+  }
+  for (std::thread & worker : workers) {
+    worker.join();
+  }
+
+  msync(address, size, MS_SYNC);
+  munmap(address, size);
+  _x0_data = _p_data = _status_data = _solve_time_data = _sqp_iter_data = _u0_data = nullptr;
+  _x_traj_data = _u_traj_data = nullptr;
+
+  Summary summary;
+  summary.num_samples = num_samples;
+  for (size_t worker_failures : num_failures) {
+    summary.num_failures += worker_failures;
+  }
+  summary.elapsed_time =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  return summary;
+}
+
+void DatasetGenerator::solve_chunk(
+  AcadosSolver & solver, size_t begin, size_t end, size_t & num_failures)
+{
+  bool last_solve_failed = false;
+  for (size_t i = begin; i < end; i++) {
+    // A failed solution is not used as initial guess
+    if (!_options.warm_start || last_solve_failed) {
+      solver.reset();
+    }
+    solver.set_initial_state_values_unchecked(_x0_data + i * _nx);
+    for (unsigned int stage = 0; stage <= _N && _np > 0; stage++) {
+      solver.set_runtime_parameters_unchecked(stage, _p_data + i * _np);
+    }
+    const auto start_time = std::chrono::steady_clock::now();
+    int status = solver.solve();
+    _solve_time_data[i] =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    _status_data[i] = static_cast<double>(status);
+    _sqp_iter_data[i] = static_cast<double>(solver.solve_stats().sqp_iter);
+    solver.get_control_values_unchecked(0, _u0_data + i * _nu);
+    if (_options.store_trajectories) {
+      for (unsigned int stage = 0; stage <= _N; stage++) {
+        solver.get_state_values_unchecked(stage, _x_traj_data + (i * (_N + 1) + stage) * _nx);
+      }
+      for (unsigned int stage = 0; stage < _N; stage++) {
+        solver.get_control_values_unchecked(stage, _u_traj_data + (i * _N + stage) * _nu);
+      }
+    }
+    last_solve_failed = (status != ACADOS_SUCCESS);
+    num_failures += last_solve_failed ? 1 : 0;
+  }
+}
+
+//####################################################################
+// DatasetReader
+//####################################################################
+
+DatasetReader::DatasetReader(std::string const & path)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(
+            "Error in 'DatasetReader::DatasetReader()': failed to open '" + path + "'!");
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 ||
+    static_cast<size_t>(file_stat.st_size) < sizeof(DatasetFileHeader))
+  {
+    close(fd);
+    throw std::runtime_error(
+            "Error in 'DatasetReader::DatasetReader()': invalid file '" + path + "'!");
+  }
+  _size = static_cast<size_t>(file_stat.st_size);
+  _address = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (_address == MAP_FAILED) {
+    _address = nullptr;
+    throw std::runtime_error(
+            "Error in 'DatasetReader::DatasetReader()': mmap() failed for '" + path + "'!");
+  }
+
+  // Validate the headers
+  _header = static_cast<DatasetFileHeader const *>(_address);
+  _columns = reinterpret_cast<DatasetColumnHeader const *>(
+    static_cast<char const *>(_address) + sizeof(DatasetFileHeader));
+  bool is_valid = std::memcmp(_header->magic, DATASET_MAGIC, sizeof(DATASET_MAGIC)) == 0 &&
+    _header->version == DATASET_VERSION &&
+    sizeof(DatasetFileHeader) + _header->num_columns * sizeof(DatasetColumnHeader) <= _size;
+  for (uint32_t j = 0; is_valid && j < _header->num_columns; j++) {
+    is_valid = _columns[j].offset % sizeof(double) == 0 &&
+      _columns[j].offset + _header->num_samples * _columns[j].width * sizeof(double) <= _size;
+  }
+  if (!is_valid) {
+    munmap(_address, _size);
+    _address = nullptr;
+    throw std::runtime_error(
+            "Error in 'DatasetReader::DatasetReader()': '" + path + "' is not a valid dataset!");
+  }
+}
+
+DatasetReader::~DatasetReader()
+{
+  if (_address != nullptr) {
+    munmap(_address, _size);
+  }
+}
+
+size_t DatasetReader::num_samples() const
+{
+  return _header->num_samples;
+}
+
+std::vector<std::string> DatasetReader::column_names() const
+{
+  std::vector<std::string> names;
+  for (uint32_t j = 0; j < _header->num_columns; j++) {
+    names.emplace_back(_columns[j].name, strnlen(_columns[j].name, sizeof(_columns[j].name)));
+  }
+  return names;
+}
+
+bool DatasetReader::has_column(std::string const & name) const
+{
+  std::vector<std::string> names = column_names();
+  return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+DatasetReader::ColumnMap DatasetReader::column(std::string const & name) const
+{
+  std::vector<std::string> names = column_names();
+  for (uint32_t j = 0; j < _header->num_columns; j++) {
+    if (names[j] == name) {
+      return ColumnMap(
+        reinterpret_cast<double const *>(static_cast<char const *>(_address) + _columns[j].offset),
+        static_cast<Eigen::Index>(_header->num_samples),
+        static_cast<Eigen::Index>(_columns[j].width));
+    }
+  }
+  throw std::invalid_argument("Error in 'DatasetReader::column()': unknown column '" + name + "'!");
+}
+
+}  // namespace acados
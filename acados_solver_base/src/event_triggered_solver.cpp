@@ -0,0 +1,136 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_solver_base/event_triggered_solver.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "acados_solver_base/acados_solver_utils.hpp"
+
+namespace acados
+{
+
+EventTriggeredSolver::EventTriggeredSolver(AcadosSolver & solver, Options const & options)
+: _solver(solver),
+  _max_skipped_solves(options.max_skipped_solves)
+{
+  const unsigned int nx = _solver.nx();
+  if (_solver.N() == 0 || nx == 0) {
+    throw std::invalid_argument(
+            "Error in 'EventTriggeredSolver::EventTriggeredSolver()': "
+            "the solver is not initialized!");
+  }
+  if (options.default_threshold < 0.0) {
+    throw std::invalid_argument(
+            "Error in 'EventTriggeredSolver::EventTriggeredSolver()': "
+            "the thresholds must be positive!");
+  }
+  _thresholds = Eigen::VectorXd::Constant(nx, options.default_threshold);
+  for (auto const & [key, key_thresholds] : options.x0_thresholds) {
+    auto it = _solver.x_index_map().find(key);
+    if (it == _solver.x_index_map().end() || it->second.size() != key_thresholds.size()) {
+      throw std::invalid_argument(
+              "Error in 'EventTriggeredSolver::EventTriggeredSolver()': "
+              "missing key or invalid thresholds for key '" + key + "'!");
+    }
+    for (size_t i = 0; i < key_thresholds.size(); i++) {
+      if (key_thresholds[i] < 0.0) {
+        throw std::invalid_argument(
+                "Error in 'EventTriggeredSolver::EventTriggeredSolver()': "
+                "the thresholds must be positive!");
+      }
+      _thresholds[it->second[i]] = key_thresholds[i];
+    }
+  }
+  _x0_prediction = Eigen::VectorXd::Zero(nx);
+  _prediction_error = Eigen::VectorXd::Zero(nx);
+  _x_buffer = Eigen::VectorXd::Zero(nx);
+  _u_buffer = Eigen::VectorXd::Zero(_solver.nu());
+  _first_sampling_interval = _solver.sampling_intervals()[0];
+}
+
+int EventTriggeredSolver::solve(ValueVector & x0)
+{
+  return solve(x0, _first_sampling_interval);
+}
+
+int EventTriggeredSolver::solve(ValueVector & x0, double elapsed_time)
+{
+  if (x0.size() != _solver.nx()) {
+    throw std::invalid_argument(
+            "Error in 'EventTriggeredSolver::solve()': the size of x0 should match nx!");
+  }
+  // Reuse the shifted plan if possible (the interpolator is updated once, by the prediction check)
+  bool can_skip = !_force_solve &&
+    _consecutive_skips < _max_skipped_solves &&
+    _solver.solve_stats().status == ACADOS_SUCCESS;
+  if (can_skip && is_prediction_accurate(x0, elapsed_time) &&
+    utils::shift_warm_start(_solver, elapsed_time, _interpolator, _x_buffer, _u_buffer))
+  {
+    _last_solve_skipped = true;
+    _consecutive_skips++;
+    _num_skipped_solves++;
+    return _solver.solve_stats().status;
+  }
+
+  // Solve
+  _last_solve_skipped = false;
+  _force_solve = false;
+  _consecutive_skips = 0;
+  _num_solves++;
+  if (_solver.set_initial_state_values(x0) != 0) {
+    return -1;
+  }
+  return _solver.solve();
+}
+
+void EventTriggeredSolver::force_next_solve()
+{
+  _force_solve = true;
+}
+
+bool EventTriggeredSolver::last_solve_skipped() const
+{
+  return _last_solve_skipped;
+}
+
+size_t EventTriggeredSolver::num_solves() const
+{
+  return _num_solves;
+}
+
+size_t EventTriggeredSolver::num_skipped_solves() const
+{
+  return _num_skipped_solves;
+}
+
+const Eigen::VectorXd & EventTriggeredSolver::prediction_error() const
+{
+  return _prediction_error;
+}
+
+bool EventTriggeredSolver::is_prediction_accurate(ValueVector const & x0, double elapsed_time)
+{
+  if (_interpolator.update(_solver) != 0) {
+    return false;
+  }
+  _interpolator.evaluate_state(elapsed_time, _x0_prediction);
+  _prediction_error = Eigen::Map<const Eigen::VectorXd>(x0.data(), x0.size()) - _x0_prediction;
+  return (_prediction_error.array().abs() <= _thresholds.array()).all();
+}
+
+}  // namespace acados
@@ -0,0 +1,160 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_solver_base/flat_index_map.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace acados
+{
+
+FlatIndexMap::FlatIndexMap(IndexMap const & index_map)
+{
+  assign(index_map);
+}
+
+void FlatIndexMap::assign(IndexMap const & index_map)
+{
+  _keys.clear();
+  _keys.reserve(index_map.size());
+  for (const auto & [key, indexes] : index_map) {
+    _keys.push_back(key);
+  }
+  std::sort(_keys.begin(), _keys.end());
+
+  _offsets.assign(1, 0);
+  _indexes.clear();
+  _is_contiguous.clear();
+  for (const auto & key : _keys) {
+    const IndexVector & key_indexes = index_map.at(key);
+    bool is_contiguous = true;
+    for (size_t i = 1; i < key_indexes.size(); i++) {
+      is_contiguous &= (key_indexes[i] == key_indexes[0] + i);
+    }
+    _indexes.insert(_indexes.end(), key_indexes.begin(), key_indexes.end());
+    _offsets.push_back(_indexes.size());
+    _is_contiguous.push_back(is_contiguous);
+  }
+}
+
+size_t FlatIndexMap::num_keys() const
+{
+  return _keys.size();
+}
+
+size_t FlatIndexMap::total_size() const
+{
+  return _indexes.size();
+}
+
+size_t FlatIndexMap::find(std::string const & key) const
+{
+  auto it = std::lower_bound(_keys.begin(), _keys.end(), key);
+  if (it == _keys.end() || *it != key) {
+    return npos;
+  }
+  return static_cast<size_t>(it - _keys.begin());
+}
+
+const std::string & FlatIndexMap::key(size_t key_id) const
+{
+  return _keys[key_id];
+}
+
+size_t FlatIndexMap::size(size_t key_id) const
+{
+  return _offsets[key_id + 1] - _offsets[key_id];
+}
+
+const unsigned int * FlatIndexMap::indexes(size_t key_id) const
+{
+  return _indexes.data() + _offsets[key_id];
+}
+
+bool FlatIndexMap::is_contiguous(size_t key_id) const
+{
+  return _is_contiguous[key_id];
+}
+
+size_t FlatIndexMap::offset(size_t key_id) const
+{
+  return _offsets[key_id];
+}
+
+void FlatIndexMap::gather(size_t key_id, const double * values, double * key_values) const
+{
+  const size_t n = size(key_id);
+  const unsigned int * idx = indexes(key_id);
+  if (n == 0) {
+    return;
+  }
+  if (_is_contiguous[key_id]) {
+    std::memcpy(key_values, values + idx[0], n * sizeof(double));
+  } else {
+    for (size_t i = 0; i < n; i++) {
+      key_values[i] = values[idx[i]];
+    }
+  }
+}
+
+void FlatIndexMap::scatter(size_t key_id, const double * key_values, double * values) const
+{
+  const size_t n = size(key_id);
+  const unsigned int * idx = indexes(key_id);
+  if (n == 0) {
+    return;
+  }
+  if (_is_contiguous[key_id]) {
+    std::memcpy(values + idx[0], key_values, n * sizeof(double));
+  } else {
+    for (size_t i = 0; i < n; i++) {
+      values[idx[i]] = key_values[i];
+    }
+  }
+}
+
+void FlatIndexMap::fill_vector_from_map(ValueMap const & values_map, double * values) const
+{
+  for (size_t key_id = 0; key_id < num_keys(); key_id++) {
+    scatter(key_id, values_map.at(_keys[key_id]).data(), values);
+  }
+}
+
+void FlatIndexMap::fill_map_from_values(const double * values, ValueMap & value_map) const
+{
+  for (size_t key_id = 0; key_id < num_keys(); key_id++) {
+    ValueVector & key_values = value_map[_keys[key_id]];
+    key_values.resize(size(key_id));
+    gather(key_id, values, key_values.data());
+  }
+}
+
+void FlatIndexMap::pack(const double * values, double * packed_values) const
+{
+  for (size_t key_id = 0; key_id < num_keys(); key_id++) {
+    gather(key_id, values, packed_values + _offsets[key_id]);
+  }
+}
+
+void FlatIndexMap::unpack(const double * packed_values, double * values) const
+{
+  for (size_t key_id = 0; key_id < num_keys(); key_id++) {
+    scatter(key_id, packed_values + _offsets[key_id], values);
+  }
+}
+
+}  // namespace acados
@@ -0,0 +1,358 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_solver_base/mppi_controller.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace acados
+{
+
+namespace
+{
+
+/// @brief Write the entries of a (possibly partial) value map into a dense vector.
+void fill_dense_from_map(
+  IndexMap const & index_map,
+  ValueMap const & values_map,
+  std::string const & option_name,
+  Eigen::VectorXd & values)
+{
+  for (auto const & [key, key_values] : values_map) {
+    auto it = index_map.find(key);
+    if (it == index_map.end() || it->second.size() != key_values.size()) {
+      throw std::invalid_argument(
+              "Error in 'MppiController::MppiController()': "
+              "missing key or invalid size for key '" + key + "' of '" + option_name + "'!");
+    }
+    for (size_t i = 0; i < key_values.size(); i++) {
+      values[it->second[i]] = key_values[i];
+    }
+  }
+}
+
+}  // namespace
+
+MppiController::MppiController(SolverFactory solver_factory, Options const & options)
+: _num_samples(options.num_samples),
+  _lambda(options.lambda),
+  _terminal_weight(options.terminal_weight)
+{
+  if (!solver_factory) {
+    throw std::invalid_argument(
+            "Error in 'MppiController::MppiController()': invalid solver factory!");
+  }
+  if (options.num_samples == 0 || options.lambda <= 0.0 || options.default_noise_std < 0.0) {
+    throw std::invalid_argument(
+            "Error in 'MppiController::MppiController()': "
+            "'num_samples' and 'lambda' must be strictly positive, and the noise positive!");
+  }
+  std::shared_ptr<AcadosSolver> first_solver = solver_factory();
+  if (!first_solver || first_solver->N() == 0 || first_solver->nx() == 0) {
+    throw std::invalid_argument(
+            "Error in 'MppiController::MppiController()': "
+            "the solver factory must return initialized solvers!");
+  }
+  _nx = first_solver->nx();
+  _nu = first_solver->nu();
+  _np = first_solver->np();
+  _N = first_solver->N();
+  _sampling_intervals = first_solver->sampling_intervals();
+  IndexMap const & x_index_map = first_solver->x_index_map();
+  IndexMap const & u_index_map = first_solver->u_index_map();
+
+  // Noise and control limits (per stage, then stacked over the horizon)
+  Eigen::VectorXd noise_std = Eigen::VectorXd::Constant(_nu, options.default_noise_std);
+  const double infinity = std::numeric_limits<double>::infinity();
+  Eigen::VectorXd u_lower = Eigen::VectorXd::Constant(_nu, -infinity);
+  Eigen::VectorXd u_upper = Eigen::VectorXd::Constant(_nu, infinity);
+  fill_dense_from_map(u_index_map, options.noise_std, "noise_std", noise_std);
+  fill_dense_from_map(u_index_map, options.u_lower, "u_lower", u_lower);
+  fill_dense_from_map(u_index_map, options.u_upper, "u_upper", u_upper);
+  if ((noise_std.array() < 0.0).any() || (u_lower.array() > u_upper.array()).any()) {
+    throw std::invalid_argument(
+            "Error in 'MppiController::MppiController()': invalid noise or control limits!");
+  }
+  _noise_std = noise_std.replicate(_N, 1);
+  _u_lower = u_lower.replicate(_N, 1);
+  _u_upper = u_upper.replicate(_N, 1);
+
+  // Cost
+  _x_ref = Eigen::VectorXd::Zero(_nx);
+  _x_weights = Eigen::VectorXd::Zero(_nx);
+  _u_weights = Eigen::VectorXd::Zero(_nu);
+  fill_dense_from_map(x_index_map, options.x_ref, "x_ref", _x_ref);
+  for (auto const & [key, key_values] : options.x_ref) {
+    ValueMap default_weights = {{key, ValueVector(key_values.size(), 1.0)}};
+    fill_dense_from_map(x_index_map, default_weights, "x_ref", _x_weights);
+  }
+  fill_dense_from_map(x_index_map, options.x_weights, "x_weights", _x_weights);
+  fill_dense_from_map(u_index_map, options.u_weights, "u_weights", _u_weights);
+
+  // Buffers
+  _x0 = Eigen::VectorXd::Zero(_nx);
+  _p = Eigen::VectorXd::Zero(_np);
+  _costs = Eigen::VectorXd::Zero(_num_samples);
+  _weights = Eigen::VectorXd::Zero(_num_samples);
+  _u_samples = Eigen::MatrixXd::Zero(_nu * _N, _num_samples);
+  _x_trajectory = Eigen::MatrixXd::Zero(_nx, _N + 1);
+  reset();
+
+  // Workers (one solver instance and one contiguous batch of samples each)
+  unsigned int num_threads = (options.num_threads > 0) ?
+    options.num_threads : std::max(1u, std::thread::hardware_concurrency());
+  num_threads = std::min(num_threads, _num_samples);
+  const size_t batch_size = (_num_samples + num_threads - 1) / num_threads;
+  _workers.resize(num_threads);
+  for (unsigned int t = 0; t < num_threads; t++) {
+    Worker & worker = _workers[t];
+    worker.solver = (t == 0) ? first_solver : solver_factory();
+    if (!worker.solver || worker.solver->nx() != _nx || worker.solver->nu() != _nu ||
+      worker.solver->np() != _np || worker.solver->N() != _N)
+    {
+      throw std::invalid_argument(
+              "Error in 'MppiController::MppiController()': "
+              "the solver factory must return solvers of the same dimensions!");
+    }
+    worker.generator.seed(options.seed + t);
+    worker.begin = std::min<size_t>(_num_samples, t * batch_size);
+    worker.end = std::min<size_t>(_num_samples, worker.begin + batch_size);
+    worker.x = Eigen::MatrixXd::Zero(_nx, worker.end - worker.begin);
+    worker.x_next = Eigen::VectorXd::Zero(_nx);
+    worker.z = Eigen::VectorXd::Zero(worker.solver->nz());  // Null data if nz = 0 (accepted)
+  }
+  for (Worker & worker : _workers) {
+    worker.thread = std::thread(&MppiController::worker_loop, this, std::ref(worker));
+  }
+}
+
+MppiController::~MppiController()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop_requested = true;
+  }
+  _start_cv.notify_all();
+  for (Worker & worker : _workers) {
+    if (worker.thread.joinable()) {
+      worker.thread.join();
+    }
+  }
+}
+
+void MppiController::set_runtime_parameters(ValueVector const & p)
+{
+  if (p.size() != _np) {
+    throw std::invalid_argument(
+            "Error in 'MppiController::set_runtime_parameters()': the size of p should match np!");
+  }
+  _p = Eigen::Map<const Eigen::VectorXd>(p.data(), _np);
+}
+
+int MppiController::solve(ValueVector const & x0)
+{
+  if (x0.size() != _nx) {
+    throw std::invalid_argument(
+            "Error in 'MppiController::solve()': the size of x0 should match nx!");
+  }
+  _x0 = Eigen::Map<const Eigen::VectorXd>(x0.data(), _nx);
+
+  // Roll out all samples in parallel
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _num_pending = static_cast<unsigned int>(_workers.size());
+    _generation++;
+    _start_cv.notify_all();
+    _done_cv.wait(lock, [this] {return _num_pending == 0;});
+  }
+
+  // Path-integral update (the failed rollouts have an infinite cost)
+  _min_cost = _costs.minCoeff();
+  if (!std::isfinite(_min_cost)) {
+    for (Worker const & worker : _workers) {
+      if (worker.status != 0) {
+        return worker.status;
+      }
+    }
+    return ACADOS_NAN_DETECTED;
+  }
+  _weights = (-(_costs.array() - _min_cost) / _lambda).exp();
+  const double weights_sum = _weights.sum();
+  _effective_sample_size = weights_sum * weights_sum / _weights.squaredNorm();
+  _u_nominal.noalias() = _u_samples * _weights / weights_sum;
+  _u_trajectory = Eigen::Map<const Eigen::MatrixXd>(_u_nominal.data(), _nu, _N);
+
+  // Nominal state trajectory
+  Worker & worker = _workers[0];
+  _x_trajectory.col(0) = _x0;
+  for (unsigned int stage = 0; stage < _N; stage++) {
+    int status = worker.solver->simulate_unchecked(
+      _sampling_intervals[stage], _x_trajectory.col(stage).data(),
+      _u_nominal.data() + stage * _nu, _p.data(), _x_trajectory.col(stage + 1).data(),
+      worker.z.data());
+    if (status != 0) {
+      return status;
+    }
+  }
+  return 0;
+}
+
+void MppiController::shift()
+{
+  if (_N > 1) {
+    _u_nominal.head(_nu * (_N - 1)) = _u_nominal.tail(_nu * (_N - 1)).eval();
+  }
+  _u_trajectory = Eigen::Map<const Eigen::MatrixXd>(_u_nominal.data(), _nu, _N);
+}
+
+void MppiController::reset()
+{
+  _u_nominal = Eigen::VectorXd::Zero(_nu * _N);
+  clamp(_u_nominal);
+  _u_trajectory = Eigen::Map<const Eigen::MatrixXd>(_u_nominal.data(), _nu, _N);
+}
+
+const Eigen::MatrixXd & MppiController::control_trajectory() const
+{
+  return _u_trajectory;
+}
+
+const Eigen::MatrixXd & MppiController::state_trajectory() const
+{
+  return _x_trajectory;
+}
+
+double MppiController::min_cost() const
+{
+  return _min_cost;
+}
+
+double MppiController::effective_sample_size() const
+{
+  return _effective_sample_size;
+}
+
+unsigned int MppiController::num_threads() const
+{
+  return static_cast<unsigned int>(_workers.size());
+}
+
+void MppiController::warm_start(AcadosSolver & solver) const
+{
+  if (solver.nx() != _nx || solver.nu() != _nu || solver.N() != _N) {
+    throw std::invalid_argument(
+            "Error in 'MppiController::warm_start()': inconsistent solver dimensions!");
+  }
+  for (unsigned int stage = 0; stage <= _N; stage++) {
+    solver.initialize_state_values_unchecked(stage, _x_trajectory.col(stage).data());
+  }
+  for (unsigned int stage = 0; stage < _N; stage++) {
+    solver.initialize_control_values_unchecked(stage, _u_nominal.data() + stage * _nu);
+  }
+}
+
+//####################################################################
+// Rollouts
+//####################################################################
+
+void MppiController::worker_loop(Worker & worker)
+{
+  uint64_t last_generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _start_cv.wait(
+        lock, [&] {return _stop_requested || _generation != last_generation;});
+      if (_stop_requested) {
+        return;
+      }
+      last_generation = _generation;
+    }
+    rollout(worker);
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _num_pending--;
+    }
+    _done_cv.notify_one();
+  }
+}
+
+void MppiController::rollout(Worker & worker)
+{
+  const size_t num_rollouts = worker.end - worker.begin;
+  if (num_rollouts == 0) {
+    return;
+  }
+  worker.status = 0;
+
+  // Sample the control sequences (the first sample is the nominal sequence)
+  std::normal_distribution<double> distribution(0.0, 1.0);
+  for (size_t j = worker.begin; j < worker.end; j++) {
+    auto sequence = _u_samples.col(j);
+    if (j == 0) {
+      sequence = _u_nominal;
+      continue;
+    }
+    for (Eigen::Index i = 0; i < sequence.size(); i++) {
+      sequence[i] = _u_nominal[i] + _noise_std[i] * distribution(worker.generator);
+    }
+    clamp(sequence);
+  }
+
+  // Roll out stage by stage, the costs being accumulated over all the rollouts at once
+  auto costs = _costs.segment(worker.begin, num_rollouts);
+  auto u_samples = _u_samples.middleCols(worker.begin, num_rollouts);
+  costs.setZero();
+  worker.x.colwise() = _x0;
+  for (unsigned int stage = 0; stage < _N; stage++) {
+    auto u_k = u_samples.middleRows(stage * _nu, _nu);
+    costs +=
+      ((worker.x.colwise() - _x_ref).array().square().colwise() * _x_weights.array())
+      .colwise().sum().matrix().transpose() +
+      (u_k.array().square().colwise() * _u_weights.array()).colwise().sum().matrix().transpose();
+    for (size_t j = 0; j < num_rollouts; j++) {
+      if (!std::isfinite(costs[j])) {
+        continue;
+      }
+      int status = worker.solver->simulate_unchecked(
+        _sampling_intervals[stage], worker.x.col(j).data(),
+        u_samples.col(j).data() + stage * _nu, _p.data(), worker.x_next.data(), worker.z.data());
+      if (status != 0) {
+        worker.status = status;
+        costs[j] = std::numeric_limits<double>::infinity();
+        continue;
+      }
+      worker.x.col(j) = worker.x_next;
+    }
+  }
+  costs += _terminal_weight *
+    ((worker.x.colwise() - _x_ref).array().square().colwise() * _x_weights.array())
+    .colwise().sum().matrix().transpose();
+  costs = costs.unaryExpr(
+    [](double cost) {return std::isfinite(cost) ? cost : std::numeric_limits<double>::infinity();});
+}
+
+void MppiController::clamp(Eigen::Ref<Eigen::VectorXd> sequence) const
+{
+  sequence = sequence.cwiseMax(_u_lower).cwiseMin(_u_upper);
+}
+
+}  // namespace acados
@@ -0,0 +1,121 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_solver_base/named_vector.hpp"
+
+#include <stdexcept>
+
+namespace acados
+{
+
+NamedVector::NamedVector(std::shared_ptr<const FlatIndexMap> layout)
+: _layout(layout)
+{
+  if (!_layout) {
+    throw std::invalid_argument("Error in 'NamedVector::NamedVector()': null layout!");
+  }
+  _packed_values = Eigen::VectorXd::Zero(_layout->total_size());
+}
+
+NamedVector::NamedVector(std::shared_ptr<const FlatIndexMap> layout, ValueMap const & values_map)
+: NamedVector(layout)
+{
+  for (size_t key_id = 0; key_id < _layout->num_keys(); key_id++) {
+    auto it = values_map.find(_layout->key(key_id));
+    if (it == values_map.end() || it->second.size() != _layout->size(key_id)) {
+      throw std::invalid_argument(
+              "Error in 'NamedVector::NamedVector()': missing or invalid values for key '" +
+              _layout->key(key_id) + "'!");
+    }
+    at(key_id) = ConstView(it->second.data(), it->second.size());
+  }
+}
+
+const std::shared_ptr<const FlatIndexMap> & NamedVector::layout() const
+{
+  return _layout;
+}
+
+size_t NamedVector::size() const
+{
+  return static_cast<size_t>(_packed_values.size());
+}
+
+bool NamedVector::contains(std::string const & key) const
+{
+  return _layout && _layout->find(key) != FlatIndexMap::npos;
+}
+
+NamedVector::View NamedVector::operator[](std::string const & key)
+{
+  size_t key_id = _layout ? _layout->find(key) : FlatIndexMap::npos;
+  if (key_id == FlatIndexMap::npos) {
+    throw std::out_of_range("Error in 'NamedVector::operator[]': key '" + key + "' not found!");
+  }
+  return at(key_id);
+}
+
+NamedVector::ConstView NamedVector::operator[](std::string const & key) const
+{
+  size_t key_id = _layout ? _layout->find(key) : FlatIndexMap::npos;
+  if (key_id == FlatIndexMap::npos) {
+    throw std::out_of_range("Error in 'NamedVector::operator[]': key '" + key + "' not found!");
+  }
+  return at(key_id);
+}
+
+NamedVector::View NamedVector::at(size_t key_id)
+{
+  return View(_packed_values.data() + _layout->offset(key_id), _layout->size(key_id));
+}
+
+NamedVector::ConstView NamedVector::at(size_t key_id) const
+{
+  return ConstView(_packed_values.data() + _layout->offset(key_id), _layout->size(key_id));
+}
+
+double * NamedVector::data()
+{
+  return _packed_values.data();
+}
+
+const double * NamedVector::data() const
+{
+  return _packed_values.data();
+}
+
+void NamedVector::from_values(const double * values)
+{
+  _layout->pack(values, _packed_values.data());
+}
+
+void NamedVector::to_values(double * values) const
+{
+  _layout->unpack(_packed_values.data(), values);
+}
+
+ValueMap NamedVector::to_map() const
+{
+  ValueMap value_map;
+  for (size_t key_id = 0; key_id < _layout->num_keys(); key_id++) {
+    ConstView key_values = at(key_id);
+    value_map[_layout->key(key_id)] =
+      ValueVector(key_values.data(), key_values.data() + key_values.size());
+  }
+  return value_map;
+}
+
+}  // namespace acados
@@ -0,0 +1,714 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_solver_base/shared_memory_solver.hpp"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "acados_solver_base/acados_solver_logging.hpp"
+
+namespace acados
+{
+
+namespace
+{
+
+constexpr uint64_t kMagic = 0x41434144534f4c56ULL;  // "ACADSOLV"
+constexpr uint32_t kVersion = 2;
+constexpr size_t kAlignment = 64;
+
+constexpr size_t align_up(size_t size)
+{
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+/// @brief State of the segment header.
+constexpr uint32_t kHeaderReady = 1;
+constexpr uint32_t kHeaderClosed = 2;
+
+/// @brief Size of the fixed (non-double) part of the slots.
+constexpr size_t kRequestHeaderSize = 16;
+constexpr size_t kResponseHeaderSize = 32;
+constexpr size_t kNumStats = 8;
+
+}  // namespace
+
+struct SharedMemoryChannel::Header
+{
+  uint64_t magic;
+  uint32_t version;
+  uint32_t capacity;
+  Dimensions dims;
+  int64_t host_pid;
+  /// @brief Set by the host once the header is initialized (`kHeaderReady`), and on close (`kHeaderClosed`).
+  std::atomic<uint32_t> ready;
+};
+
+struct SharedMemoryChannel::Ring
+{
+  /// @brief Index of the next slot to be written (producer side).
+  alignas(kAlignment) std::atomic<uint64_t> head;
+  /// @brief Index of the next slot to be read (consumer side).
+  alignas(kAlignment) std::atomic<uint64_t> tail;
+};
+
+static_assert(
+  std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+  "SharedMemoryChannel requires address-free (lock-free) atomics");
+
+//####################################################################
+// SharedMemoryChannel
+//####################################################################
+
+std::unique_ptr<SharedMemoryChannel> SharedMemoryChannel::create(
+  std::string const & name, Dimensions const & dims, uint32_t capacity)
+{
+  if (capacity == 0 || dims.N == 0) {
+    throw std::invalid_argument(
+            "Error in 'SharedMemoryChannel::create()': invalid capacity or dimensions!");
+  }
+  std::unique_ptr<SharedMemoryChannel> channel(new SharedMemoryChannel());
+  channel->_name = name;
+  channel->_dims = dims;
+  channel->compute_layout(capacity);
+
+  // Start from a fresh segment (stale clients keep their own mapping)
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    throw std::runtime_error(
+            "Error in 'SharedMemoryChannel::create()': shm_open() failed for '" + name + "': " +
+            std::strerror(errno));
+  }
+  if (ftruncate(fd, static_cast<off_t>(channel->_size)) != 0) {
+    close(fd);
+    shm_unlink(name.c_str());
+    throw std::runtime_error(
+            "Error in 'SharedMemoryChannel::create()': ftruncate() failed for '" + name + "'!");
+  }
+  void * address = mmap(nullptr, channel->_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    throw std::runtime_error(
+            "Error in 'SharedMemoryChannel::create()': mmap() failed for '" + name + "'!");
+  }
+  channel->_owner = true;
+  channel->_address = address;
+
+  // Initialize the header and the rings
+  uint8_t * base = static_cast<uint8_t *>(address);
+  channel->_header = new (base) Header();
+  channel->_request_ring = new (base + align_up(sizeof(Header))) Ring();
+  channel->_response_ring = new (base + align_up(sizeof(Header)) + sizeof(Ring)) Ring();
+  channel->_request_slots = base + align_up(sizeof(Header)) + 2 * sizeof(Ring);
+  channel->_response_slots = channel->_request_slots + capacity * channel->_request_slot_size;
+  channel->_request_ring->head.store(0);
+  channel->_request_ring->tail.store(0);
+  channel->_response_ring->head.store(0);
+  channel->_response_ring->tail.store(0);
+
+  Header & header = *channel->_header;
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.capacity = capacity;
+  header.dims = dims;
+  header.host_pid = static_cast<int64_t>(getpid());
+  header.ready.store(kHeaderReady, std::memory_order_release);
+  return channel;
+}
+
+std::unique_ptr<SharedMemoryChannel> SharedMemoryChannel::open(
+  std::string const & name, std::chrono::nanoseconds timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  std::unique_ptr<SharedMemoryChannel> channel(new SharedMemoryChannel());
+  channel->_name = name;
+
+  // Wait for the segment to be created and initialized
+  while (true) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd >= 0) {
+      struct stat segment_stat;
+      if (fstat(fd, &segment_stat) == 0 &&
+        static_cast<size_t>(segment_stat.st_size) >= align_up(sizeof(Header)))
+      {
+        size_t size = static_cast<size_t>(segment_stat.st_size);
+        void * address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (address != MAP_FAILED) {
+          Header * header = static_cast<Header *>(address);
+          if (header->ready.load(std::memory_order_acquire) == kHeaderReady) {
+            if (header->magic != kMagic || header->version != kVersion) {
+              munmap(address, size);
+              close(fd);
+              throw std::runtime_error(
+                      "Error in 'SharedMemoryChannel::open()': invalid segment '" + name + "'!");
+            }
+            channel->_dims = header->dims;
+            channel->compute_layout(header->capacity);
+            if (channel->_size > size) {
+              munmap(address, size);
+              close(fd);
+              throw std::runtime_error(
+                      "Error in 'SharedMemoryChannel::open()': truncated segment '" + name + "'!");
+            }
+            close(fd);
+            uint8_t * base = static_cast<uint8_t *>(address);
+            channel->_address = address;
+            channel->_size = size;
+            channel->_header = header;
+            channel->_request_ring = reinterpret_cast<Ring *>(base + align_up(sizeof(Header)));
+            channel->_response_ring = channel->_request_ring + 1;
+            channel->_request_slots = base + align_up(sizeof(Header)) + 2 * sizeof(Ring);
+            channel->_response_slots =
+              channel->_request_slots + channel->_capacity * channel->_request_slot_size;
+            return channel;
+          }
+          munmap(address, size);
+        }
+      }
+      close(fd);
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      throw std::runtime_error(
+              "Error in 'SharedMemoryChannel::open()': no host found for '" + name + "'!");
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+  if (_owner && _header != nullptr) {
+    // Notify the clients (they keep their mapping of this segment until they reconnect)
+    _header->ready.store(kHeaderClosed, std::memory_order_release);
+  }
+  if (_address != nullptr) {
+    munmap(_address, _size);
+  }
+  if (_owner) {
+    shm_unlink(_name.c_str());
+  }
+}
+
+const std::string & SharedMemoryChannel::name() const
+{
+  return _name;
+}
+
+const SharedMemoryChannel::Dimensions & SharedMemoryChannel::dims() const
+{
+  return _dims;
+}
+
+int64_t SharedMemoryChannel::host_pid() const
+{
+  return _header->host_pid;
+}
+
+bool SharedMemoryChannel::is_host_alive() const
+{
+  if (is_host_closed()) {
+    return false;
+  }
+  return kill(static_cast<pid_t>(_header->host_pid), 0) == 0 || errno == EPERM;
+}
+
+bool SharedMemoryChannel::is_host_closed() const
+{
+  return _header->ready.load(std::memory_order_acquire) == kHeaderClosed;
+}
+
+void SharedMemoryChannel::compute_layout(uint32_t capacity)
+{
+  const size_t N = _dims.N;
+  _capacity = capacity;
+  _request_slot_size = align_up(
+    kRequestHeaderSize + sizeof(double) * (
+      _dims.nx + _dims.np * (N + 1) + 2 * _dims.nbx * (N - 1) + 2 * _dims.nbu * N) +
+    sizeof(uint8_t) * (N + 1));
+  _response_slot_size = align_up(
+    kResponseHeaderSize + sizeof(double) * (kNumStats + _dims.nx * (N + 1) + _dims.nu * N));
+  _size = align_up(sizeof(Header)) + 2 * sizeof(Ring) +
+    capacity * (_request_slot_size + _response_slot_size);
+}
+
+SharedMemoryChannel::RequestView SharedMemoryChannel::request_view(uint64_t index)
+{
+  const size_t N = _dims.N;
+  uint8_t * slot = _request_slots + (index % _capacity) * _request_slot_size;
+  RequestView view;
+  view.id = reinterpret_cast<uint64_t *>(slot);
+  view.flags = reinterpret_cast<uint32_t *>(slot + sizeof(uint64_t));
+  view.x0 = reinterpret_cast<double *>(slot + kRequestHeaderSize);
+  view.p = view.x0 + _dims.nx;
+  view.lbx = view.p + _dims.np * (N + 1);
+  view.ubx = view.lbx + _dims.nbx * (N - 1);
+  view.lbu = view.ubx + _dims.nbx * (N - 1);
+  view.ubu = view.lbu + _dims.nbu * N;
+  view.p_stages = reinterpret_cast<uint8_t *>(view.ubu + _dims.nbu * N);
+  return view;
+}
+
+SharedMemoryChannel::ResponseView SharedMemoryChannel::response_view(uint64_t index)
+{
+  const size_t N = _dims.N;
+  uint8_t * slot = _response_slots + (index % _capacity) * _response_slot_size;
+  ResponseView view;
+  view.id = reinterpret_cast<uint64_t *>(slot);
+  view.status = reinterpret_cast<int32_t *>(slot + 8);
+  view.sqp_iter = reinterpret_cast<int32_t *>(slot + 12);
+  view.qp_iter = reinterpret_cast<int32_t *>(slot + 16);
+  view.stats = reinterpret_cast<double *>(slot + kResponseHeaderSize);
+  view.x = view.stats + kNumStats;
+  view.u = view.x + _dims.nx * (N + 1);
+  return view;
+}
+
+bool SharedMemoryChannel::try_begin_request(RequestView & view)
+{
+  uint64_t head = _request_ring->head.load(std::memory_order_relaxed);
+  if (head - _request_ring->tail.load(std::memory_order_acquire) >= _capacity) {
+    return false;
+  }
+  view = request_view(head);
+  return true;
+}
+
+void SharedMemoryChannel::commit_request()
+{
+  uint64_t head = _request_ring->head.load(std::memory_order_relaxed);
+  _request_ring->head.store(head + 1, std::memory_order_release);
+}
+
+bool SharedMemoryChannel::try_peek_request(RequestView & view)
+{
+  uint64_t tail = _request_ring->tail.load(std::memory_order_relaxed);
+  if (tail == _request_ring->head.load(std::memory_order_acquire)) {
+    return false;
+  }
+  view = request_view(tail);
+  return true;
+}
+
+void SharedMemoryChannel::pop_request()
+{
+  uint64_t tail = _request_ring->tail.load(std::memory_order_relaxed);
+  _request_ring->tail.store(tail + 1, std::memory_order_release);
+}
+
+bool SharedMemoryChannel::try_begin_response(ResponseView & view)
+{
+  uint64_t head = _response_ring->head.load(std::memory_order_relaxed);
+  if (head - _response_ring->tail.load(std::memory_order_acquire) >= _capacity) {
+    return false;
+  }
+  view = response_view(head);
+  return true;
+}
+
+void SharedMemoryChannel::commit_response()
+{
+  uint64_t head = _response_ring->head.load(std::memory_order_relaxed);
+  _response_ring->head.store(head + 1, std::memory_order_release);
+}
+
+bool SharedMemoryChannel::try_peek_response(ResponseView & view)
+{
+  uint64_t tail = _response_ring->tail.load(std::memory_order_relaxed);
+  if (tail == _response_ring->head.load(std::memory_order_acquire)) {
+    return false;
+  }
+  view = response_view(tail);
+  return true;
+}
+
+void SharedMemoryChannel::pop_response()
+{
+  uint64_t tail = _response_ring->tail.load(std::memory_order_relaxed);
+  _response_ring->tail.store(tail + 1, std::memory_order_release);
+}
+
+//####################################################################
+// SolverHost
+//####################################################################
+
+SolverHost::SolverHost(AcadosSolver & solver, std::string const & channel_name, uint32_t capacity)
+: _solver(solver)
+{
+  if (_solver.N() == 0) {
+    throw std::invalid_argument("Error in 'SolverHost::SolverHost()': the solver is not initialized!");
+  }
+  SharedMemoryChannel::Dimensions dims;
+  dims.nx = _solver.nx();
+  dims.nu = _solver.nu();
+  dims.np = _solver.np();
+  dims.N = _solver.N();
+  dims.nbx = _solver.dims().nbx;
+  dims.nbu = _solver.dims().nbu;
+  _channel = SharedMemoryChannel::create(channel_name, dims, capacity);
+}
+
+bool SolverHost::serve_once()
+{
+  SharedMemoryChannel::RequestView request;
+  if (!_channel->try_peek_request(request)) {
+    return false;
+  }
+  const SharedMemoryChannel::Dimensions & dims = _channel->dims();
+
+  // Apply the request, then release the slot
+  const uint64_t id = *request.id;
+  const uint32_t flags = *request.flags;
+  if (flags & SharedMemoryChannel::HAS_INITIAL_STATE) {
+    _solver.set_initial_state_values_unchecked(request.x0);
+  }
+  if ((flags & SharedMemoryChannel::HAS_PARAMETERS) && dims.np > 0) {
+    for (unsigned int stage = 0; stage <= dims.N; stage++) {
+      if (request.p_stages[stage] != 0) {
+        _solver.set_runtime_parameters_unchecked(stage, request.p + stage * dims.np);
+      }
+    }
+  }
+  if ((flags & SharedMemoryChannel::HAS_STATE_BOUNDS) && dims.nbx > 0) {
+    for (unsigned int stage = 1; stage < dims.N; stage++) {
+      _solver.set_state_bounds_unchecked(
+        stage, request.lbx + (stage - 1) * dims.nbx, request.ubx + (stage - 1) * dims.nbx);
+    }
+  }
+  if ((flags & SharedMemoryChannel::HAS_CONTROL_BOUNDS) && dims.nbu > 0) {
+    for (unsigned int stage = 0; stage < dims.N; stage++) {
+      _solver.set_control_bounds_unchecked(
+        stage, request.lbu + stage * dims.nbu, request.ubu + stage * dims.nbu);
+    }
+  }
+  _channel->pop_request();
+
+  // Solve and send the response
+  int status = _solver.solve();
+  _num_requests++;
+  SharedMemoryChannel::ResponseView response;
+  if (!_channel->try_begin_response(response)) {
+    _solver.logger().log(
+      LogLevel::WARNING,
+      "SolverHost: the response ring is full, dropping the response to request %" PRIu64 "!", id);
+    return true;
+  }
+  const AcadosSolver::SolveStats & stats = _solver.solve_stats();
+  *response.id = id;
+  *response.status = status;
+  *response.sqp_iter = stats.sqp_iter;
+  *response.qp_iter = stats.qp_iter;
+  response.stats[0] = stats.time_tot;
+  response.stats[1] = stats.time_lin;
+  response.stats[2] = stats.time_qp;
+  response.stats[3] = stats.time_reg;
+  response.stats[4] = stats.res_stat;
+  response.stats[5] = stats.res_eq;
+  response.stats[6] = stats.res_ineq;
+  response.stats[7] = stats.res_comp;
+  for (unsigned int stage = 0; stage <= dims.N; stage++) {
+    _solver.get_state_values_unchecked(stage, response.x + stage * dims.nx);
+  }
+  for (unsigned int stage = 0; stage < dims.N; stage++) {
+    _solver.get_control_values_unchecked(stage, response.u + stage * dims.nu);
+  }
+  _channel->commit_response();
+  return true;
+}
+
+void SolverHost::serve(
+  std::atomic<bool> const & stop_requested,
+  std::chrono::nanoseconds spin_duration)
+{
+  auto last_request_time = std::chrono::steady_clock::now();
+  while (!stop_requested.load(std::memory_order_relaxed)) {
+    if (serve_once()) {
+      last_request_time = std::chrono::steady_clock::now();
+    } else if (std::chrono::steady_clock::now() - last_request_time > spin_duration) {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }
+}
+
+size_t SolverHost::num_requests() const
+{
+  return _num_requests;
+}
+
+//####################################################################
+// RemoteSolver
+//####################################################################
+
+RemoteSolver::RemoteSolver(
+  std::string const & channel_name,
+  std::chrono::nanoseconds connect_timeout)
+: _channel(SharedMemoryChannel::open(channel_name, connect_timeout))
+{
+  const SharedMemoryChannel::Dimensions & dims = _channel->dims();
+  _x0 = Eigen::VectorXd::Zero(dims.nx);
+  _p = ColumnMajorXd::Zero(dims.np, dims.N + 1);
+  _lbx = ColumnMajorXd::Zero(dims.nbx, dims.N - 1);
+  _ubx = ColumnMajorXd::Zero(dims.nbx, dims.N - 1);
+  _lbu = ColumnMajorXd::Zero(dims.nbu, dims.N);
+  _ubu = ColumnMajorXd::Zero(dims.nbu, dims.N);
+  _x_traj = ColumnMajorXd::Zero(dims.nx, dims.N + 1);
+  _u_traj = ColumnMajorXd::Zero(dims.nu, dims.N);
+  _p_stages.assign(dims.N + 1, 0);
+  _sent_p_stages.assign(dims.N + 1, 0);
+}
+
+unsigned int RemoteSolver::nx() const
+{
+  return _channel->dims().nx;
+}
+
+unsigned int RemoteSolver::nu() const
+{
+  return _channel->dims().nu;
+}
+
+unsigned int RemoteSolver::np() const
+{
+  return _channel->dims().np;
+}
+
+unsigned int RemoteSolver::N() const
+{
+  return _channel->dims().N;
+}
+
+int RemoteSolver::set_initial_state_values(ValueVector const & x_0)
+{
+  if (x_0.size() != nx()) {
+    throw std::range_error(
+            "Error in 'RemoteSolver::set_initial_state_values()': "
+            "Inconsistent parameters, the size of x_0 should match nx!");
+  }
+  _x0 = Eigen::Map<const Eigen::VectorXd>(x_0.data(), x_0.size());
+  _flags |= SharedMemoryChannel::HAS_INITIAL_STATE;
+  return 0;
+}
+
+int RemoteSolver::set_runtime_parameters(ValueVector const & p_i)
+{
+  for (unsigned int stage = 0; stage <= N(); stage++) {
+    set_runtime_parameters(stage, p_i);
+  }
+  return 0;
+}
+
+int RemoteSolver::set_runtime_parameters(unsigned int stage, ValueVector const & p_i)
+{
+  if (stage > N() || p_i.size() != np()) {
+    throw std::range_error(
+            "Error in 'RemoteSolver::set_runtime_parameters()': "
+            "Inconsistent parameters, invalid stage or the size of p_i does not match np!");
+  }
+  _p.col(stage) = Eigen::Map<const Eigen::VectorXd>(p_i.data(), p_i.size());
+  _p_stages[stage] = 1;
+  _flags |= SharedMemoryChannel::HAS_PARAMETERS;
+  return 0;
+}
+
+int RemoteSolver::set_state_bounds(ValueVector const & lbx, ValueVector const & ubx)
+{
+  if (lbx.size() != _channel->dims().nbx || ubx.size() != _channel->dims().nbx) {
+    throw std::range_error(
+            "Error in 'RemoteSolver::set_state_bounds()': "
+            "Inconsistent parameters, the size of lbx and ubx should match nbx!");
+  }
+  _lbx.colwise() = Eigen::Map<const Eigen::VectorXd>(lbx.data(), lbx.size());
+  _ubx.colwise() = Eigen::Map<const Eigen::VectorXd>(ubx.data(), ubx.size());
+  _flags |= SharedMemoryChannel::HAS_STATE_BOUNDS;
+  return 0;
+}
+
+int RemoteSolver::set_control_bounds(ValueVector const & lbu, ValueVector const & ubu)
+{
+  if (lbu.size() != _channel->dims().nbu || ubu.size() != _channel->dims().nbu) {
+    throw std::range_error(
+            "Error in 'RemoteSolver::set_control_bounds()': "
+            "Inconsistent parameters, the size of lbu and ubu should match nbu!");
+  }
+  _lbu.colwise() = Eigen::Map<const Eigen::VectorXd>(lbu.data(), lbu.size());
+  _ubu.colwise() = Eigen::Map<const Eigen::VectorXd>(ubu.data(), ubu.size());
+  _flags |= SharedMemoryChannel::HAS_CONTROL_BOUNDS;
+  return 0;
+}
+
+int RemoteSolver::solve(std::chrono::nanoseconds timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+  // Reconnect to the new segment if the host was restarted
+  if ((_host_lost || _channel->is_host_closed()) && !reconnect()) {
+    _host_lost = true;
+    return STATUS_HOST_DEAD;
+  }
+
+  // Drop the late responses of previous (timed out) requests
+  SharedMemoryChannel::ResponseView response;
+  while (_channel->try_peek_response(response)) {
+    _channel->pop_response();
+  }
+
+  // Send the request
+  SharedMemoryChannel::RequestView request;
+  if (!_channel->try_begin_request(request)) {
+    _host_lost = !is_host_alive();
+    return _host_lost ? STATUS_HOST_DEAD : STATUS_TIMEOUT;
+  }
+  const uint64_t id = _next_id++;
+  *request.id = id;
+  *request.flags = _flags;
+  if (_flags & SharedMemoryChannel::HAS_INITIAL_STATE) {
+    std::memcpy(request.x0, _x0.data(), sizeof(double) * _x0.size());
+  }
+  if (_flags & SharedMemoryChannel::HAS_PARAMETERS) {
+    std::memcpy(request.p, _p.data(), sizeof(double) * _p.size());
+    std::memcpy(request.p_stages, _p_stages.data(), _p_stages.size());
+    for (size_t stage = 0; stage < _p_stages.size(); stage++) {
+      _sent_p_stages[stage] |= _p_stages[stage];
+    }
+    std::fill(_p_stages.begin(), _p_stages.end(), 0);
+  }
+  if (_flags & SharedMemoryChannel::HAS_STATE_BOUNDS) {
+    std::memcpy(request.lbx, _lbx.data(), sizeof(double) * _lbx.size());
+    std::memcpy(request.ubx, _ubx.data(), sizeof(double) * _ubx.size());
+  }
+  if (_flags & SharedMemoryChannel::HAS_CONTROL_BOUNDS) {
+    std::memcpy(request.lbu, _lbu.data(), sizeof(double) * _lbu.size());
+    std::memcpy(request.ubu, _ubu.data(), sizeof(double) * _ubu.size());
+  }
+  _channel->commit_request();
+  _sent_flags |= _flags;
+  _flags = 0;
+
+  // Wait for the response (busy-waiting first, then yielding)
+  unsigned int num_polls = 0;
+  while (true) {
+    if (_channel->try_peek_response(response)) {
+      if (*response.id == id) {
+        _solve_stats.status = *response.status;
+        _solve_stats.sqp_iter = *response.sqp_iter;
+        _solve_stats.qp_iter = *response.qp_iter;
+        _solve_stats.time_tot = response.stats[0];
+        _solve_stats.time_lin = response.stats[1];
+        _solve_stats.time_qp = response.stats[2];
+        _solve_stats.time_reg = response.stats[3];
+        _solve_stats.res_stat = response.stats[4];
+        _solve_stats.res_eq = response.stats[5];
+        _solve_stats.res_ineq = response.stats[6];
+        _solve_stats.res_comp = response.stats[7];
+        std::memcpy(_x_traj.data(), response.x, sizeof(double) * _x_traj.size());
+        std::memcpy(_u_traj.data(), response.u, sizeof(double) * _u_traj.size());
+        _channel->pop_response();
+        return _solve_stats.status;
+      }
+      _channel->pop_response();
+      continue;
+    }
+    if (++num_polls % 1024 == 0) {
+      if (!is_host_alive()) {
+        _host_lost = true;
+        return STATUS_HOST_DEAD;
+      }
+      if (std::chrono::steady_clock::now() >= deadline) {
+        return STATUS_TIMEOUT;
+      }
+      std::this_thread::yield();
+    }
+  }
+}
+
+const AcadosSolver::SolveStats & RemoteSolver::solve_stats() const
+{
+  return _solve_stats;
+}
+
+ValueVector RemoteSolver::get_state_values(unsigned int stage) const
+{
+  if (stage > N()) {
+    throw std::range_error("Error in 'RemoteSolver::get_state_values()': invalid stage!");
+  }
+  return ValueVector(_x_traj.col(stage).data(), _x_traj.col(stage).data() + nx());
+}
+
+ValueVector RemoteSolver::get_control_values(unsigned int stage) const
+{
+  if (stage >= N()) {
+    throw std::range_error("Error in 'RemoteSolver::get_control_values()': invalid stage!");
+  }
+  return ValueVector(_u_traj.col(stage).data(), _u_traj.col(stage).data() + nu());
+}
+
+void RemoteSolver::get_state_values_unchecked(unsigned int stage, double * x_i) const noexcept
+{
+  std::memcpy(x_i, _x_traj.col(stage).data(), sizeof(double) * nx());
+}
+
+void RemoteSolver::get_control_values_unchecked(unsigned int stage, double * u_i) const noexcept
+{
+  std::memcpy(u_i, _u_traj.col(stage).data(), sizeof(double) * nu());
+}
+
+bool RemoteSolver::is_host_alive() const
+{
+  return _channel->is_host_alive();
+}
+
+bool RemoteSolver::reconnect(std::chrono::nanoseconds timeout)
+{
+  std::unique_ptr<SharedMemoryChannel> channel;
+  try {
+    channel = SharedMemoryChannel::open(_channel->name(), timeout);
+  } catch (std::runtime_error const &) {
+    return false;  // No (initialized) segment yet
+  }
+  const SharedMemoryChannel::Dimensions & dims = channel->dims();
+  const SharedMemoryChannel::Dimensions & expected_dims = _channel->dims();
+  if (!channel->is_host_alive() || dims.nx != expected_dims.nx || dims.nu != expected_dims.nu ||
+    dims.np != expected_dims.np || dims.N != expected_dims.N || dims.nbx != expected_dims.nbx ||
+    dims.nbu != expected_dims.nbu)
+  {
+    return false;
+  }
+  _channel = std::move(channel);
+  _host_lost = false;
+
+  // The new host starts from the defaults of the plugin: send everything again
+  _flags |= _sent_flags;
+  for (size_t stage = 0; stage < _p_stages.size(); stage++) {
+    _p_stages[stage] |= _sent_p_stages[stage];
+  }
+  return true;
+}
+
+}  // namespace acados
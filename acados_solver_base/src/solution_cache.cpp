@@ -0,0 +1,205 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_solver_base/solution_cache.hpp"
+
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+
+namespace acados
+{
+
+SolutionCache::SolutionCache(Options const & options)
+: _options(options)
+{
+  if (_options.capacity == 0) {
+    throw std::invalid_argument("Error in 'SolutionCache::SolutionCache()': null capacity!");
+  }
+  if (_options.p_indexes.size() != _options.p_resolution.size()) {
+    throw std::invalid_argument(
+            "Error in 'SolutionCache::SolutionCache()': "
+            "the sizes of 'p_indexes' and 'p_resolution' do not match!");
+  }
+  for (double resolution : _options.x0_resolution) {
+    if (!(resolution > 0.0)) {
+      throw std::invalid_argument(
+              "Error in 'SolutionCache::SolutionCache()': "
+              "the resolutions must be strictly positive!");
+    }
+  }
+  for (double resolution : _options.p_resolution) {
+    if (!(resolution > 0.0)) {
+      throw std::invalid_argument(
+              "Error in 'SolutionCache::SolutionCache()': "
+              "the resolutions must be strictly positive!");
+    }
+  }
+}
+
+bool SolutionCache::store(AcadosSolver & solver)
+{
+  if (solver.solve_stats().status != ACADOS_SUCCESS) {
+    return false;
+  }
+  const unsigned int N = solver.N();
+
+  // Compute key
+  _x0_buffer.resize(solver.nx());
+  solver.get_state_values_unchecked(0, _x0_buffer.data());
+  compute_key(solver, _x0_buffer.data());
+
+  // Reuse the entry of the same cell, the least recently used one, or create a new one
+  EntryList::iterator entry_it;
+  auto grid_it = _grid.find(_cell);
+  if (grid_it != _grid.end()) {
+    entry_it = grid_it->second;
+    _grid.erase(grid_it);
+  } else if (_entries.size() >= _options.capacity) {
+    entry_it = std::prev(_entries.end());
+    _grid.erase(entry_it->cell);
+  } else {
+    entry_it = _entries.emplace(_entries.end());
+  }
+  _entries.splice(_entries.begin(), _entries, entry_it);
+
+  Entry & entry = *entry_it;
+  entry.cell = _cell;
+  entry.scaled_key = _scaled_key;
+  entry.x_traj.resize(solver.nx(), N + 1);
+  entry.u_traj.resize(solver.nu(), N);
+  for (unsigned int stage = 0; stage <= N; stage++) {
+    solver.get_state_values_unchecked(stage, entry.x_traj.col(stage).data());
+  }
+  for (unsigned int stage = 0; stage < N; stage++) {
+    solver.get_control_values_unchecked(stage, entry.u_traj.col(stage).data());
+  }
+  _grid[entry.cell] = entry_it;
+  return true;
+}
+
+bool SolutionCache::seed(AcadosSolver & solver, ValueVector const & x0)
+{
+  if (x0.size() != solver.nx()) {
+    throw std::invalid_argument(
+            "Error in 'SolutionCache::seed()': the size of x0 should match nx!");
+  }
+  if (_entries.empty()) {
+    _misses++;
+    return false;
+  }
+  compute_key(solver, x0.data());
+
+  // Same cell, or else nearest neighbour
+  EntryList::iterator best_it = _entries.end();
+  auto grid_it = _grid.find(_cell);
+  if (grid_it != _grid.end()) {
+    best_it = grid_it->second;
+  } else {
+    double best_distance = _options.max_distance;
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+      double distance = (it->scaled_key - _scaled_key).norm();
+      if (distance <= best_distance) {
+        best_distance = distance;
+        best_it = it;
+      }
+    }
+  }
+  const unsigned int N = solver.N();
+  if (
+    best_it == _entries.end() ||
+    best_it->x_traj.rows() != solver.nx() || best_it->x_traj.cols() != N + 1 ||
+    best_it->u_traj.rows() != solver.nu())
+  {
+    _misses++;
+    return false;
+  }
+
+  // Initialize the solver and mark as most recently used
+  _entries.splice(_entries.begin(), _entries, best_it);
+  for (unsigned int stage = 0; stage <= N; stage++) {
+    solver.initialize_state_values_unchecked(stage, best_it->x_traj.col(stage).data());
+  }
+  for (unsigned int stage = 0; stage < N; stage++) {
+    solver.initialize_control_values_unchecked(stage, best_it->u_traj.col(stage).data());
+  }
+  _hits++;
+  return true;
+}
+
+size_t SolutionCache::size() const
+{
+  return _entries.size();
+}
+
+void SolutionCache::clear()
+{
+  _grid.clear();
+  _entries.clear();
+}
+
+size_t SolutionCache::hits() const
+{
+  return _hits;
+}
+
+size_t SolutionCache::misses() const
+{
+  return _misses;
+}
+
+void SolutionCache::compute_key(AcadosSolver & solver, const double * x0)
+{
+  const unsigned int nx = solver.nx();
+  if (_options.x0_resolution.size() != nx) {
+    throw std::invalid_argument(
+            "Error in 'SolutionCache': the size of 'x0_resolution' should match nx!");
+  }
+  _scaled_key.resize(nx + _options.p_indexes.size());
+  for (unsigned int i = 0; i < nx; i++) {
+    _scaled_key[i] = x0[i] / _options.x0_resolution[i];
+  }
+  if (!_options.p_indexes.empty()) {
+    _p_buffer.resize(solver.np());
+    solver.get_parameter_values_unchecked(0, _p_buffer.data());
+    for (size_t i = 0; i < _options.p_indexes.size(); i++) {
+      if (_options.p_indexes[i] >= _p_buffer.size()) {
+        throw std::invalid_argument("Error in 'SolutionCache': invalid parameter index!");
+      }
+      _scaled_key[nx + i] = _p_buffer[_options.p_indexes[i]] / _options.p_resolution[i];
+    }
+  }
+  quantize(_scaled_key, _cell);
+}
+
+void SolutionCache::quantize(Eigen::VectorXd const & scaled_key, std::vector<int64_t> & cell)
+{
+  cell.resize(scaled_key.size());
+  for (Eigen::Index i = 0; i < scaled_key.size(); i++) {
+    cell[i] = static_cast<int64_t>(std::llround(scaled_key[i]));
+  }
+}
+
+size_t SolutionCache::CellHash::operator()(std::vector<int64_t> const & cell) const
+{
+  size_t seed = cell.size();
+  for (int64_t value : cell) {
+    seed ^= std::hash<int64_t>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+  }
+  return seed;
+}
+
+}  // namespace acados
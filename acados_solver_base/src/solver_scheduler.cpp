@@ -0,0 +1,275 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_solver_base/solver_scheduler.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "acados_solver_base/acados_solver_logging.hpp"
+
+namespace acados
+{
+
+SolverScheduler::SolverScheduler(Options const & options)
+: _options(options)
+{
+  if (_options.num_workers == 0) {
+    throw std::invalid_argument(
+            "Error in 'SolverScheduler::SolverScheduler()': at least one worker is required!");
+  }
+  if (!_options.cpu_cores.empty() && _options.cpu_cores.size() != _options.num_workers) {
+    throw std::invalid_argument(
+            "Error in 'SolverScheduler::SolverScheduler()': "
+            "the size of 'cpu_cores' should match 'num_workers'!");
+  }
+}
+
+SolverScheduler::~SolverScheduler()
+{
+  stop();
+}
+
+size_t SolverScheduler::add_task(AcadosSolver & solver, TaskOptions const & options)
+{
+  if (_running) {
+    throw std::logic_error(
+            "Error in 'SolverScheduler::add_task()': the scheduler is running!");
+  }
+  Task task;
+  task.solver = &solver;
+  task.options = options;
+  if (task.options.deadline == std::chrono::nanoseconds::zero()) {
+    task.options.deadline = task.options.period;
+  }
+  if (task.options.period.count() <= 0 || task.options.deadline.count() <= 0) {
+    throw std::invalid_argument(
+            "Error in 'SolverScheduler::add_task()': "
+            "the period and the deadline must be strictly positive!");
+  }
+  _tasks.push_back(task);
+  return _tasks.size() - 1;
+}
+
+size_t SolverScheduler::num_tasks() const
+{
+  return _tasks.size();
+}
+
+void SolverScheduler::start()
+{
+  if (_running) {
+    return;
+  }
+  // The first RTI feedback phase requires a preparation phase
+  for (Task & task : _tasks) {
+    if (task.options.use_rti) {
+      task.solver->solve_rti(RtiStage::PREPARATION);
+    }
+  }
+  const Clock::time_point now = Clock::now();
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _ready_jobs.clear();
+    for (Task & task : _tasks) {
+      task.next_release = now + task.options.offset;
+      task.busy = false;
+    }
+    _running = true;
+  }
+  for (unsigned int worker_index = 0; worker_index < _options.num_workers; worker_index++) {
+    _workers.emplace_back(&SolverScheduler::worker_loop, this, worker_index);
+  }
+  _dispatcher = std::thread(&SolverScheduler::dispatcher_loop, this);
+}
+
+void SolverScheduler::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_running) {
+      return;
+    }
+    _running = false;
+  }
+  _dispatcher_cv.notify_all();
+  _workers_cv.notify_all();
+  if (_dispatcher.joinable()) {
+    _dispatcher.join();
+  }
+  for (std::thread & worker : _workers) {
+    worker.join();
+  }
+  _workers.clear();
+  _ready_jobs.clear();
+}
+
+bool SolverScheduler::is_running() const
+{
+  return _running;
+}
+
+SolverScheduler::TaskStats SolverScheduler::task_stats(size_t task_index) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _tasks.at(task_index).stats;
+}
+
+void SolverScheduler::reset_stats()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (Task & task : _tasks) {
+    task.stats = TaskStats();
+  }
+}
+
+//####################################################################
+// Scheduling
+//####################################################################
+
+bool SolverScheduler::later_deadline(Job const & lhs, Job const & rhs)
+{
+  return lhs.deadline > rhs.deadline;
+}
+
+void SolverScheduler::push_job(Job const & job)
+{
+  _ready_jobs.push_back(job);
+  std::push_heap(_ready_jobs.begin(), _ready_jobs.end(), later_deadline);
+}
+
+void SolverScheduler::dispatcher_loop()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (_running) {
+    const Clock::time_point now = Clock::now();
+    Clock::time_point next_wakeup = Clock::time_point::max();
+    bool has_new_jobs = false;
+    for (size_t task_index = 0; task_index < _tasks.size(); task_index++) {
+      Task & task = _tasks[task_index];
+      while (task.next_release <= now) {
+        const Clock::time_point release = task.next_release;
+        task.next_release += task.options.period;
+        task.stats.num_releases++;
+        if (task.busy) {
+          task.stats.num_overruns++;
+          continue;
+        }
+        task.busy = true;
+        JobType type = task.options.use_rti ? JobType::RTI_FEEDBACK : JobType::SOLVE;
+        push_job({release + task.options.deadline, release, task_index, type});
+        has_new_jobs = true;
+      }
+      next_wakeup = std::min(next_wakeup, task.next_release);
+    }
+    if (has_new_jobs) {
+      _workers_cv.notify_all();
+    }
+    if (next_wakeup == Clock::time_point::max()) {
+      _dispatcher_cv.wait(lock);
+    } else {
+      _dispatcher_cv.wait_until(lock, next_wakeup);
+    }
+  }
+}
+
+void SolverScheduler::worker_loop(unsigned int worker_index)
+{
+  if (!_options.cpu_cores.empty()) {
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(_options.cpu_cores[worker_index], &cpu_set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) != 0) {
+      Logger::default_logger().log(
+        LogLevel::WARNING,
+        "SolverScheduler: failed to pin worker %u to CPU %d!",
+        worker_index, _options.cpu_cores[worker_index]);
+    }
+#else
+    Logger::default_logger().log(
+      LogLevel::WARNING,
+      "SolverScheduler: thread pinning is not supported on this platform (worker %u)!",
+      worker_index);
+#endif
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _workers_cv.wait(lock, [this] {return !_running || !_ready_jobs.empty();});
+    if (!_running) {
+      return;
+    }
+    std::pop_heap(_ready_jobs.begin(), _ready_jobs.end(), later_deadline);
+    Job job = _ready_jobs.back();
+    _ready_jobs.pop_back();
+
+    lock.unlock();
+    run_job(job);
+    lock.lock();
+  }
+}
+
+void SolverScheduler::run_job(Job const & job)
+{
+  Task & task = _tasks[job.task_index];
+  AcadosSolver & solver = *task.solver;
+
+  // Solve (the task is flagged busy, hence no concurrent access to the solver)
+  int status = 0;
+  if (job.type == JobType::RTI_PREPARATION) {
+    status = solver.solve_rti(RtiStage::PREPARATION);
+  } else {
+    if (task.options.before_solve) {
+      task.options.before_solve(solver);
+    }
+    status = (job.type == JobType::SOLVE) ? solver.solve() : solver.solve_rti(RtiStage::FEEDBACK);
+    if (task.options.after_solve) {
+      task.options.after_solve(solver, status);
+    }
+  }
+  const Clock::time_point completion = Clock::now();
+
+  // Update statistics
+  std::lock_guard<std::mutex> lock(_mutex);
+  TaskStats & stats = task.stats;
+  if (completion > job.deadline) {
+    stats.num_deadline_misses++;
+  }
+  if (job.type == JobType::RTI_PREPARATION) {
+    task.busy = false;
+    return;
+  }
+  const double response_time = std::chrono::duration<double>(completion - job.release).count();
+  stats.num_completed++;
+  stats.max_response_time = std::max(stats.max_response_time, response_time);
+  stats.mean_response_time += (response_time - stats.mean_response_time) / stats.num_completed;
+  stats.last_status = status;
+  if (job.type == JobType::RTI_FEEDBACK) {
+    // Prepare the next iteration before the next release
+    push_job({task.next_release, job.release, job.task_index, JobType::RTI_PREPARATION});
+    _workers_cv.notify_one();
+  } else {
+    task.busy = false;
+  }
+}
+
+}  // namespace acados
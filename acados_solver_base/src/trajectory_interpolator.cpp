@@ -0,0 +1,145 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+#include "acados_solver_base/trajectory_interpolator.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace acados
+{
+
+void TrajectoryInterpolator::set_dynamics(DynamicsFunction dynamics)
+{
+  _dynamics = dynamics;
+}
+
+int TrajectoryInterpolator::update(AcadosSolver & solver)
+{
+  const unsigned int N = solver.N();
+  if (N == 0) {
+    solver.logger().log(
+      LogLevel::ERROR,
+      "Error in 'TrajectoryInterpolator::update()': the solver is not initialized!");
+    return 1;
+  }
+
+  // Time grid (read in place, see `AcadosSolver::sampling_intervals()`)
+  const double * sampling_intervals = solver.get_nlp_in()->Ts;
+  _t.resize(N + 1);
+  _t[0] = 0.0;
+  for (unsigned int k = 0; k < N; k++) {
+    _t[k + 1] = _t[k] + sampling_intervals[k];
+  }
+
+  // Trajectories
+  _x.resize(solver.nx(), N + 1);
+  _dx.resize(solver.nx(), N + 1);
+  _u.resize(solver.nu(), N);
+  for (unsigned int stage = 0; stage <= N; stage++) {
+    solver.get_state_values_unchecked(stage, _x.col(stage).data());
+  }
+  for (unsigned int stage = 0; stage < N; stage++) {
+    solver.get_control_values_unchecked(stage, _u.col(stage).data());
+  }
+  compute_derivatives();
+  return 0;
+}
+
+bool TrajectoryInterpolator::is_ready() const
+{
+  return _t.size() > 1;
+}
+
+double TrajectoryInterpolator::horizon() const
+{
+  return is_ready() ? _t[_t.size() - 1] : 0.0;
+}
+
+double TrajectoryInterpolator::node_time(unsigned int stage) const
+{
+  assert(is_ready() && stage < _t.size());
+  return _t[stage];
+}
+
+void TrajectoryInterpolator::evaluate_state(double t, Eigen::Ref<Eigen::VectorXd> x) const
+{
+  assert(is_ready() && x.size() == _x.rows());
+  const unsigned int k = find_interval(t);
+  const double h = _t[k + 1] - _t[k];
+  const double s = (t - _t[k]) / h;
+  const double s2 = s * s;
+  const double s3 = s2 * s;
+  const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+  const double h10 = s3 - 2.0 * s2 + s;
+  const double h01 = -2.0 * s3 + 3.0 * s2;
+  const double h11 = s3 - s2;
+  x.noalias() = h00 * _x.col(k);
+  x.noalias() += (h10 * h) * _dx.col(k);
+  x.noalias() += h01 * _x.col(k + 1);
+  x.noalias() += (h11 * h) * _dx.col(k + 1);
+}
+
+void TrajectoryInterpolator::evaluate_control(double t, Eigen::Ref<Eigen::VectorXd> u) const
+{
+  assert(is_ready() && u.size() == _u.rows());
+  u = _u.col(find_interval(t));
+}
+
+void TrajectoryInterpolator::evaluate(
+  Eigen::Ref<const Eigen::VectorXd> times,
+  Eigen::Ref<ColumnMajorXd> x_traj,
+  Eigen::Ref<ColumnMajorXd> u_traj) const
+{
+  assert(x_traj.cols() == times.size() && u_traj.cols() == times.size());
+  for (Eigen::Index i = 0; i < times.size(); i++) {
+    evaluate_state(times[i], x_traj.col(i));
+    evaluate_control(times[i], u_traj.col(i));
+  }
+}
+
+unsigned int TrajectoryInterpolator::find_interval(double & t) const
+{
+  const unsigned int N = static_cast<unsigned int>(_t.size() - 1);
+  t = std::clamp(t, 0.0, _t[N]);
+  // First node strictly after t, minus one (the last interval is closed)
+  const double * it = std::upper_bound(_t.data(), _t.data() + N, t);
+  return static_cast<unsigned int>(it - _t.data()) - 1;
+}
+
+void TrajectoryInterpolator::compute_derivatives()
+{
+  const Eigen::Index N = _t.size() - 1;
+  if (_dynamics) {
+    for (Eigen::Index k = 0; k <= N; k++) {
+      // The control of the last interval is held at the terminal node
+      _dynamics(_x.col(k).data(), _u.col(std::min(k, N - 1)).data(), _dx.col(k).data());
+    }
+    return;
+  }
+  // Finite differences: one-sided at the boundaries, three-point (non-uniform) elsewhere
+  _dx.col(0) = (_x.col(1) - _x.col(0)) / (_t[1] - _t[0]);
+  _dx.col(N) = (_x.col(N) - _x.col(N - 1)) / (_t[N] - _t[N - 1]);
+  for (Eigen::Index k = 1; k < N; k++) {
+    const double h0 = _t[k] - _t[k - 1];
+    const double h1 = _t[k + 1] - _t[k];
+    _dx.col(k) = (
+      (h0 * h0) * (_x.col(k + 1) - _x.col(k)) +
+      (h1 * h1) * (_x.col(k) - _x.col(k - 1))) / (h0 * h1 * (h0 + h1));
+  }
+}
+
+}  // namespace acados
@@ -0,0 +1,98 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Micro-benchmark of the AcadosSolver wrapper overhead per setter call.
+//
+// Compares:
+//   - "virtual handles": the four virtual C-handle getters called at each call (former implementation),
+//   - "wrapper (cached)": `AcadosSolver::initialize_state_values(stage, x)`,
+//   - "wrapper (unchecked)": `AcadosSolver::initialize_state_values_unchecked(stage, x)`,
+//   - "raw C-interface": `ocp_nlp_out_set()` with handles fetched once (lower bound).
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <mock_acados_solver/mock_acados_solver.hpp>
+
+namespace
+{
+
+template<typename Func>
+double time_per_call_ns(unsigned int n_calls, Func && func)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < n_calls; i++) {
+    func(i);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / n_calls;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  unsigned int n_calls = 1000000;
+  if (argc > 1) {
+    n_calls = static_cast<unsigned int>(std::stoul(argv[1]));
+  }
+
+  mock_acados_solver_test::MockAcadosSolver mock_solver;
+  acados::AcadosSolver & solver = mock_solver;
+  if (solver.init(20, 0.05) != 0) {
+    std::cerr << "Failed to initialize the mock solver!" << std::endl;
+    return 1;
+  }
+  const unsigned int n_stages = solver.N() + 1;
+  acados::ValueVector x_i(solver.nx(), 0.1);
+
+  double t_virtual = time_per_call_ns(
+    n_calls, [&](unsigned int i) {
+      unsigned int stage = i % n_stages;
+      if (stage > static_cast<unsigned int>(solver.get_nlp_dims()->N)) {
+        return;
+      }
+      ocp_nlp_out_set(
+        solver.get_nlp_config(), solver.get_nlp_dims(), solver.get_nlp_out(), solver.get_nlp_in(),
+        stage, "x", x_i.data());
+    });
+
+  double t_wrapper = time_per_call_ns(
+    n_calls, [&](unsigned int i) {
+      solver.initialize_state_values(i % n_stages, x_i);
+    });
+
+  double t_unchecked = time_per_call_ns(
+    n_calls, [&](unsigned int i) {
+      solver.initialize_state_values_unchecked(i % n_stages, x_i.data());
+    });
+
+  ocp_nlp_config * nlp_config = solver.get_nlp_config();
+  ocp_nlp_dims * nlp_dims = solver.get_nlp_dims();
+  ocp_nlp_out * nlp_out = solver.get_nlp_out();
+  ocp_nlp_in * nlp_in = solver.get_nlp_in();
+  double t_raw = time_per_call_ns(
+    n_calls, [&](unsigned int i) {
+      ocp_nlp_out_set(nlp_config, nlp_dims, nlp_out, nlp_in, i % n_stages, "x", x_i.data());
+    });
+
+  std::cout << "Setting x_i (nx = " << solver.nx() << "), " << n_calls << " calls:" << std::endl;
+  std::cout << "   virtual handles     : " << t_virtual << " ns/call" << std::endl;
+  std::cout << "   wrapper (cached)    : " << t_wrapper << " ns/call" << std::endl;
+  std::cout << "   wrapper (unchecked) : " << t_unchecked << " ns/call" << std::endl;
+  std::cout << "   raw C-interface     : " << t_raw << " ns/call" << std::endl;
+  return 0;
+}
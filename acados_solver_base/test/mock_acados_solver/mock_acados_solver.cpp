@@ -200,12 +200,14 @@ int MockAcadosSolver::internal_simulate(
   double * z_next /* Algebraic state next value */)
 {
   if (dt <= 0.0) {
-    std::cerr
-      << "Error in MockAcadosSolver::simulate: Invalid time step, got "
-      << dt << std::endl;
+    logger().log(
+      acados::LogLevel::ERROR, "Error in MockAcadosSolver::simulate: Invalid time step, got %g", dt);
     return 10; // Error: Invalid time step
   }
-  if (x0 == nullptr || u0 == nullptr || p == nullptr || x_next == nullptr || z_next == nullptr) {
+  // The parameters and algebraic states may be null if they are empty (e.g., `std::vector::data()`)
+  if (x0 == nullptr || u0 == nullptr || x_next == nullptr ||
+    (_dims.np > 0 && p == nullptr) || (_dims.nz > 0 && z_next == nullptr))
+  {
     return 11; // Error: Null pointer passed to simulate function
   }
   if (_capsule_sim == nullptr) {
@@ -215,6 +217,14 @@ int MockAcadosSolver::internal_simulate(
   // Allocate return flag
   int ret = 0;
 
+  // Set integration time
+  sim_in_set(
+    mock_acados_solver_acados_get_sim_config(_capsule_sim),
+    mock_acados_solver_acados_get_sim_dims(_capsule_sim),
+    mock_acados_solver_acados_get_sim_in(_capsule_sim),
+    "T", &dt
+  );
+
   // Set state and control initial values
   sim_in_set(
     mock_acados_solver_acados_get_sim_config(_capsule_sim),
@@ -232,14 +242,16 @@ int MockAcadosSolver::internal_simulate(
   // Set parameters
   ret = mock_acados_solver_acados_sim_update_params(_capsule_sim, p, _dims.np);
   if (ret != 0) {
-    std::cerr << "Error in MockAcadosSolver::simulate: Failed to update parameters." << std::endl;
+    logger().log(
+      acados::LogLevel::ERROR, "Error in MockAcadosSolver::simulate: Failed to update parameters.");
     return ret;
   }
 
   // Simulate
   ret = mock_acados_solver_acados_sim_solve(_capsule_sim);
   if (ret != 0) {
-    std::cerr << "Error in MockAcadosSolver::simulate: Simulation solve failed." << std::endl;
+    logger().log(
+      acados::LogLevel::ERROR, "Error in MockAcadosSolver::simulate: Simulation solve failed.");
   }
 
   // Get next state and algebraic state
@@ -249,11 +261,58 @@ int MockAcadosSolver::internal_simulate(
     mock_acados_solver_acados_get_sim_out(_capsule_sim),
     "x", x_next
   );
-  sim_out_get(
+  if (_dims.nz > 0) {
+    sim_out_get(
+      mock_acados_solver_acados_get_sim_config(_capsule_sim),
+      mock_acados_solver_acados_get_sim_dims(_capsule_sim),
+      mock_acados_solver_acados_get_sim_out(_capsule_sim),
+      "z", z_next
+    );
+  }
+  return ret;
+}
+
+int MockAcadosSolver::internal_simulate_with_sensitivities(
+  double dt /* Time step */,
+  double * x0 /* Differential state initial value */,
+  double * u0 /* Applied controls */,
+  double * p /* Runtime parameters */,
+  double * x_next /* Differential state next value */,
+  double * z_next /* Algebraic state next value */,
+  double * S_forw /* Forward sensitivities, column-major (nx, nx + nu) */)
+{
+  if (S_forw == nullptr) {
+    return 11; // Error: Null pointer passed to simulate function
+  }
+  if (_capsule_sim == nullptr) {
+    return 12; // Error: Simulation capsule not created
+  }
+
+  // Make sure the forward sensitivities are computed by the integrator
+  bool sens_forw = true;
+  sim_opts_set(
     mock_acados_solver_acados_get_sim_config(_capsule_sim),
-    mock_acados_solver_acados_get_sim_dims(_capsule_sim),
-    mock_acados_solver_acados_get_sim_out(_capsule_sim),
-    "z", z_next
+    mock_acados_solver_acados_get_sim_opts(_capsule_sim),
+    "sens_forw", &sens_forw
+  );
+
+  int ret = internal_simulate(dt, x0, u0, p, x_next, z_next);
+  if (ret == 0) {
+    // Get forward sensitivities w.r.t. (x0, u0)
+    sim_out_get(
+      mock_acados_solver_acados_get_sim_config(_capsule_sim),
+      mock_acados_solver_acados_get_sim_dims(_capsule_sim),
+      mock_acados_solver_acados_get_sim_out(_capsule_sim),
+      "S_forw", S_forw
+    );
+  }
+
+  // Restore the default options (the other simulations do not need the sensitivities)
+  sens_forw = false;
+  sim_opts_set(
+    mock_acados_solver_acados_get_sim_config(_capsule_sim),
+    mock_acados_solver_acados_get_sim_opts(_capsule_sim),
+    "sens_forw", &sens_forw
   );
   return ret;
 }
@@ -47,6 +47,8 @@ protected:
   void internal_print_stats() const override;
 
   int internal_simulate(double dt, double * x0, double * u0, double * p, double * x_next, double * z_next) override;
+  int internal_simulate_with_sensitivities(
+    double dt, double * x0, double * u0, double * p, double * x_next, double * z_next, double * S_forw) override;
 
   ocp_nlp_in * get_nlp_in() const override;
   ocp_nlp_out * get_nlp_out() const override;
@@ -0,0 +1,23 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+// Export of the mock solver as a pluginlib plugin ("acados_solver_base/MockAcadosSolver"), so that
+// the tests of the dependent packages (controllers, nodes, Python bindings) can load it by name.
+
+#include "mock_acados_solver.hpp"
+
+#include <pluginlib/class_list_macros.hpp>
+PLUGINLIB_EXPORT_CLASS(mock_acados_solver_test::MockAcadosSolver, acados::AcadosSolver)
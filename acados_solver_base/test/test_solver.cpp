@@ -13,7 +13,28 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <mock_acados_solver/mock_acados_solver.hpp>
+#include "acados_solver_base/acados_solver_utils.hpp"
+#include "acados_solver_base/closed_loop_benchmark.hpp"
+#include "acados_solver_base/dataset_generator.hpp"
+#include "acados_solver_base/event_triggered_solver.hpp"
+#include "acados_solver_base/mppi_controller.hpp"
+#include "acados_solver_base/shared_memory_solver.hpp"
+#include "acados_solver_base/solution_cache.hpp"
+#include "acados_solver_base/solver_scheduler.hpp"
+#include "acados_solver_base/trajectory_interpolator.hpp"
 
 TEST(TestCreateMockSolver, test_init)
 {
@@ -25,6 +46,7 @@ TEST(TestCreateMockSolver, test_init)
   ASSERT_EQ(solver.N(), N);
   ASSERT_EQ(solver.Ts(), Ts);
 }
+
 TEST(TestCreateMockSolver, test_get_NLP_dimensions)
 {
   mock_acados_solver_test::MockAcadosSolver solver;
@@ -34,3 +56,709 @@ TEST(TestCreateMockSolver, test_get_NLP_dimensions)
   ASSERT_EQ(solver.dims().nu, static_cast<unsigned int>(1));
   ASSERT_EQ(solver.dims().np, static_cast<unsigned int>(2));
 }
+
+TEST(TestCreateMockSolver, test_linear_feedback)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  acados::ValueVector p {1.0, 0.1};
+  acados::ValueVector x0 {0.0, 0.0, 0.0, 0.0};
+  solver.set_runtime_parameters(p);
+  solver.set_initial_state_values(x0);
+  ASSERT_EQ(solver.solve(), 0);
+
+  ASSERT_EQ(solver.update_linear_feedback(), 0);
+  ASSERT_EQ(solver.linear_feedback_gain().rows(), static_cast<int>(solver.nu()));
+  ASSERT_EQ(solver.linear_feedback_gain().cols(), static_cast<int>(solver.nx()));
+
+  // At the linearization point, the feedback law returns the first control
+  acados::ValueVector u(solver.nu());
+  ASSERT_EQ(solver.evaluate_linear_feedback(x0, u), 0);
+  ASSERT_NEAR(u[0], solver.get_control_values(0)[0], 1e-9);
+}
+
+TEST(TestCreateMockSolver, test_solve_stats)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  acados::ValueVector p {1.0, 0.1};
+  acados::ValueVector x0 {0.0, 3.14, 0.0, 0.0};
+  solver.set_runtime_parameters(p);
+  solver.set_initial_state_values(x0);
+  int status = solver.solve();
+
+  ASSERT_EQ(solver.solve_stats().status, status);
+  ASSERT_GT(solver.solve_stats().sqp_iter, 0);
+  ASSERT_GT(solver.solve_stats().time_tot, 0.0);
+  ASSERT_LE(solver.solve_stats().time_qp, solver.solve_stats().time_tot);
+}
+
+TEST(TestCreateMockSolver, test_get_set_iterate)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  mock_acados_solver_test::MockAcadosSolver other_solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+  ASSERT_EQ(other_solver.init(20, 0.05), 0);
+
+  acados::ValueVector p {1.0, 0.1};
+  acados::ValueVector x0 {0.0, 3.14, 0.0, 0.0};
+  solver.set_runtime_parameters(p);
+  solver.set_initial_state_values(x0);
+  solver.solve();
+
+  acados::AcadosSolver::Iterate iterate;
+  ASSERT_EQ(solver.create_iterate(iterate), 0);
+  ASSERT_EQ(iterate.x.size(), static_cast<size_t>(solver.N() + 1));
+  ASSERT_EQ(iterate.pi.size(), static_cast<size_t>(solver.N()));
+  ASSERT_EQ(solver.get_iterate(iterate), 0);
+
+  // Warm-start the other solver instance
+  ASSERT_EQ(other_solver.set_iterate(iterate), 0);
+  for (unsigned int stage = 0; stage <= solver.N(); stage++) {
+    ASSERT_EQ(other_solver.get_state_values(stage), solver.get_state_values(stage));
+  }
+
+  // Not allocated
+  acados::AcadosSolver::Iterate empty_iterate;
+  ASSERT_NE(solver.get_iterate(empty_iterate), 0);
+
+  // Wrongly sized stage buffers (e.g., iterate of a solver with the same N but different nx)
+  acados::AcadosSolver::Iterate invalid_iterate = iterate;
+  invalid_iterate.x[3].setZero(solver.nx() + 2);
+  ASSERT_NE(other_solver.set_iterate(invalid_iterate), 0);
+  ASSERT_NE(other_solver.get_iterate(invalid_iterate), 0);
+  invalid_iterate = iterate;
+  invalid_iterate.lam[0].resize(0);
+  ASSERT_NE(other_solver.set_iterate(invalid_iterate), 0);
+}
+
+TEST(TestCreateMockSolver, test_set_runtime_parameters_trajectory)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  acados::ColumnMajorXd p_traj(solver.np(), solver.N() + 1);
+  for (unsigned int stage = 0; stage <= solver.N(); stage++) {
+    p_traj(0, stage) = 1.0 + 0.1 * stage;
+    p_traj(1, stage) = 0.1;
+  }
+  ASSERT_EQ(solver.set_runtime_parameters_trajectory(p_traj), 0);
+  ASSERT_EQ(solver.get_parameter_values(5)[0], p_traj(0, 5));
+
+  // Update a single parameter by name
+  acados::ColumnMajorXd mass_ball_traj = acados::ColumnMajorXd::Constant(1, solver.N() + 1, 0.2);
+  ASSERT_EQ(solver.set_runtime_parameters_trajectory("mass_ball", mass_ball_traj), 0);
+  ASSERT_EQ(solver.get_parameter_values(5)[0], p_traj(0, 5));
+  ASSERT_EQ(solver.get_parameter_values(5)[1], 0.2);
+
+  // Invalid inputs
+  ASSERT_NE(solver.set_runtime_parameters_trajectory("unknown_key", mass_ball_traj), 0);
+  ASSERT_NE(solver.set_runtime_parameters_trajectory(mass_ball_traj), 0);
+}
+
+TEST(TestCreateMockSolver, test_set_bounds_trajectory)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  // Tightening tube on theta for stages 1 to N-1
+  acados::IndexVector idxbx = {2};
+  acados::ColumnMajorXd lbx_traj(1, solver.N() - 1), ubx_traj(1, solver.N() - 1);
+  for (unsigned int i = 0; i < solver.N() - 1; i++) {
+    lbx_traj(0, i) = -1.0 + 0.01 * i;
+    ubx_traj(0, i) = 1.0 - 0.01 * i;
+  }
+  ASSERT_EQ(solver.set_state_bounds_trajectory(1, idxbx, lbx_traj, ubx_traj), 0);
+  ASSERT_EQ(solver.set_state_bounds_trajectory(1, idxbx, lbx_traj, ubx_traj, true), 0);
+
+  acados::IndexVector idxbu = {0};
+  acados::ColumnMajorXd lbu_traj = acados::ColumnMajorXd::Constant(1, solver.N(), -10.0);
+  acados::ColumnMajorXd ubu_traj = acados::ColumnMajorXd::Constant(1, solver.N(), 10.0);
+  ASSERT_EQ(solver.set_control_bounds_trajectory(0, idxbu, lbu_traj, ubu_traj), 0);
+
+  // Out of range
+  ASSERT_THROW(
+    solver.set_control_bounds_trajectory(1, idxbu, lbu_traj, ubu_traj), std::range_error);
+  ASSERT_THROW(
+    solver.set_state_bounds_trajectory(0, idxbx, lbx_traj, ubx_traj), std::range_error);
+}
+
+TEST(TestCreateMockSolver, test_unchecked_api)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  acados::ValueVector p {1.0, 0.1};
+  acados::ValueVector x0 {0.0, 3.14, 0.0, 0.0};
+  solver.set_runtime_parameters_unchecked(0, p.data());
+  ASSERT_EQ(solver.get_parameter_values(0), p);
+  acados::ValueVector p0(solver.np());
+  solver.get_parameter_values_unchecked(0, p0.data());
+  ASSERT_EQ(p0, p);
+
+  solver.initialize_state_values_unchecked(3, x0.data());
+  acados::ValueVector x3(solver.nx());
+  solver.get_state_values_unchecked(3, x3.data());
+  ASSERT_EQ(x3, x0);
+  ASSERT_EQ(solver.get_state_values(3), x0);
+}
+
+TEST(TestCreateMockSolver, test_logging)
+{
+  struct CapturingSink : public acados::LogSink
+  {
+    void write(acados::LogRecord const & record) override
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      messages.emplace_back(record.message);
+    }
+    std::mutex mutex;
+    std::vector<std::string> messages;
+  };
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+  auto capturing_sink = std::make_shared<CapturingSink>();
+  acados::ValueVector x0(solver.nx(), 0.0), u0(solver.nu(), 0.0), p(solver.np(), 1.0);
+  acados::ValueVector x_next(solver.nx()), z_next(solver.nz());
+
+  // Rate limited synchronous logging
+  solver.logger().set_sink(capturing_sink);
+  solver.logger().set_rate_limit(std::chrono::hours(1));
+  for (unsigned int i = 0; i < 5; i++) {
+    ASSERT_NE(solver.simulate(-1.0, x0, u0, p, x_next, z_next), 0);
+  }
+  ASSERT_EQ(capturing_sink->messages.size(), 1u);
+
+  // Asynchronous logging (the pending records are written when the sink is destroyed)
+  solver.logger().set_rate_limit(std::chrono::nanoseconds(0));
+  solver.logger().set_sink(std::make_shared<acados::AsyncLogSink>(capturing_sink));
+  for (unsigned int i = 0; i < 5; i++) {
+    ASSERT_NE(solver.simulate(-1.0, x0, u0, p, x_next, z_next), 0);
+  }
+  solver.logger().set_sink(nullptr);
+  ASSERT_EQ(capturing_sink->messages.size(), 6u);
+}
+
+TEST(TestCreateMockSolver, test_named_vector)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  acados::NamedVector x = solver.x_named_vector();
+  ASSERT_EQ(x.size(), solver.nx());
+  x["theta"][0] = 3.14;
+  ASSERT_EQ(solver.initialize_state_values(3, x), 0);
+  ASSERT_EQ(solver.get_state_values(3)[2], 3.14);
+
+  acados::NamedVector x_3 = solver.x_named_vector();
+  solver.get_state_values_as_map(3, x_3);
+  ASSERT_EQ(x_3.to_map(), solver.get_state_values_as_map(3));
+
+  acados::NamedVector p = solver.p_named_vector();
+  p["mass_cart"][0] = 1.0;
+  p["mass_ball"][0] = 0.1;
+  ASSERT_EQ(solver.set_runtime_parameters(p), 0);
+  ASSERT_EQ(solver.get_parameter_values(5), (acados::ValueVector{1.0, 0.1}));
+
+  // Wrong layout
+  ASSERT_NE(solver.set_runtime_parameters(0, x), 0);
+  ASSERT_THROW(solver.get_parameter_values_as_map(0, x), std::invalid_argument);
+}
+
+TEST(TestCreateMockSolver, test_solution_cache)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  acados::SolutionCache::Options options;
+  options.capacity = 2;
+  options.x0_resolution = acados::ValueVector(solver.nx(), 0.1);
+  options.p_indexes = {1};  // mass_ball
+  options.p_resolution = {0.01};
+  options.max_distance = 5.0;
+  acados::SolutionCache cache(options);
+
+  acados::ValueVector p {1.0, 0.1};
+  acados::ValueVector x0 {0.0, 3.14, 0.0, 0.0};
+  solver.set_runtime_parameters(p);
+  solver.set_initial_state_values(x0);
+  ASSERT_FALSE(cache.seed(solver, x0));
+  ASSERT_EQ(solver.solve(), 0);
+  ASSERT_TRUE(cache.store(solver));
+  ASSERT_EQ(cache.size(), 1u);
+  acados::ValueVector x_5 = solver.get_state_values(5);
+  acados::ValueVector u_5 = solver.get_control_values(5);
+
+  // Seed from a nearby initial state
+  acados::ValueVector x_zero(solver.nx(), 0.0), u_zero(solver.nu(), 0.0);
+  solver.initialize_state_values(x_zero);
+  solver.initialize_control_values(u_zero);
+  acados::ValueVector x0_near {0.01, 3.15, 0.0, 0.0};
+  ASSERT_TRUE(cache.seed(solver, x0_near));
+  ASSERT_EQ(solver.get_state_values(5), x_5);
+  ASSERT_EQ(solver.get_control_values(5), u_5);
+
+  // Too far away
+  acados::ValueVector x0_far {1.0, 0.0, 0.0, 0.0};
+  ASSERT_FALSE(cache.seed(solver, x0_far));
+  ASSERT_EQ(cache.hits(), 1u);
+  ASSERT_EQ(cache.misses(), 2u);
+}
+
+TEST(TestCreateMockSolver, test_trajectory_interpolator)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  acados::ValueVector p {1.0, 0.1};
+  acados::ValueVector x0 {0.0, 3.14, 0.0, 0.0};
+  solver.set_runtime_parameters(p);
+  solver.set_initial_state_values(x0);
+  solver.solve();
+
+  acados::TrajectoryInterpolator interpolator;
+  ASSERT_EQ(interpolator.update(solver), 0);
+  ASSERT_NEAR(interpolator.horizon(), 20 * 0.05, 1e-12);
+
+  // Interpolation at the shooting nodes
+  Eigen::VectorXd x(solver.nx()), u(solver.nu());
+  interpolator.evaluate_state(5 * 0.05, x);
+  acados::ValueVector x_5 = solver.get_state_values(5);
+  for (unsigned int i = 0; i < solver.nx(); i++) {
+    ASSERT_NEAR(x[i], x_5[i], 1e-9);
+  }
+  interpolator.evaluate_control(5.5 * 0.05, u);
+  ASSERT_EQ(u[0], solver.get_control_values(5)[0]);
+
+  // Batched evaluation
+  Eigen::VectorXd times = Eigen::VectorXd::LinSpaced(11, 0.0, interpolator.horizon());
+  acados::ColumnMajorXd x_traj(solver.nx(), times.size()), u_traj(solver.nu(), times.size());
+  interpolator.evaluate(times, x_traj, u_traj);
+  ASSERT_NEAR(x_traj(1, 0), x0[1], 1e-9);
+}
+
+TEST(TestCreateMockSolver, test_delay_compensation)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  acados::ValueVector p {1.0, 0.1};
+  acados::ValueVector x0 {0.0, 3.14, 0.0, 0.0};
+  solver.set_runtime_parameters(p);
+  solver.set_initial_state_values(x0);
+  solver.solve();
+
+  // Expected prediction over 10 ms with the current first control
+  acados::ValueVector u0 = solver.get_control_values(0);
+  acados::ValueVector x_pred(solver.nx()), z(solver.nz());
+  ASSERT_EQ(solver.simulate(0.01, x0, u0, p, x_pred, z), 0);
+
+  solver.set_delay_compensation(acados::DelayCompensation::CONFIGURED, 0.01);
+  ASSERT_EQ(solver.delay_compensation_latency(), 0.01);
+  solver.set_initial_state_values(x0);
+  solver.solve();
+  acados::ValueVector x_0 = solver.get_state_values(0);
+  for (unsigned int i = 0; i < solver.nx(); i++) {
+    ASSERT_NEAR(x_0[i], x_pred[i], 1e-9);
+  }
+}
+
+TEST(TestCreateMockSolver, test_shift_warm_start)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  acados::ValueVector p {1.0, 0.1};
+  acados::ValueVector x0 {0.0, 3.14, 0.0, 0.0};
+  solver.set_runtime_parameters(p);
+  solver.set_initial_state_values(x0);
+  solver.solve();
+  acados::ValueVector x_2 = solver.get_state_values(2);
+  acados::ValueVector u_2 = solver.get_control_values(2);
+
+  // Shift by exactly two stages
+  acados::TrajectoryInterpolator interpolator;
+  ASSERT_TRUE(acados::utils::shift_warm_start(solver, 2 * 0.05, interpolator));
+  acados::ValueVector x_0 = solver.get_state_values(0);
+  for (unsigned int i = 0; i < solver.nx(); i++) {
+    ASSERT_NEAR(x_0[i], x_2[i], 1e-9);
+  }
+  ASSERT_EQ(solver.get_control_values(0), u_2);
+
+  // Fractional shift (late tick): stage 0 is the plan at t = 0.065, i.e., the cubic Hermite
+  // interpolation on [t_1, t_2] (three-point derivatives on the uniform grid) and u_1 held.
+  std::vector<acados::ValueVector> x_plan;
+  for (unsigned int stage = 0; stage <= 3; stage++) {
+    x_plan.push_back(solver.get_state_values(stage));
+  }
+  acados::ValueVector u_1 = solver.get_control_values(1);
+  ASSERT_TRUE(acados::utils::shift_warm_start(solver, 1.3 * 0.05, interpolator));
+  const double h = 0.05, s = 0.3;
+  const double h00 = 2 * s * s * s - 3 * s * s + 1, h10 = s * s * s - 2 * s * s + s;
+  const double h01 = -2 * s * s * s + 3 * s * s, h11 = s * s * s - s * s;
+  x_0 = solver.get_state_values(0);
+  for (unsigned int i = 0; i < solver.nx(); i++) {
+    const double dx_1 = (x_plan[2][i] - x_plan[0][i]) / (2 * h);
+    const double dx_2 = (x_plan[3][i] - x_plan[1][i]) / (2 * h);
+    const double x_expected =
+      h00 * x_plan[1][i] + h10 * h * dx_1 + h01 * x_plan[2][i] + h11 * h * dx_2;
+    ASSERT_NEAR(x_0[i], x_expected, 1e-9);
+  }
+  ASSERT_EQ(solver.get_control_values(0), u_1);
+  ASSERT_THROW(acados::utils::shift_warm_start(solver, -1.0, interpolator), std::invalid_argument);
+  ASSERT_THROW(
+    acados::utils::shift_warm_start(solver, std::numeric_limits<double>::quiet_NaN(), interpolator),
+    std::invalid_argument);
+
+  // Allocation-free variant (the interpolator is already up to date)
+  Eigen::VectorXd x_buffer(solver.nx()), u_buffer(solver.nu());
+  ASSERT_EQ(interpolator.update(solver), 0);
+  acados::ValueVector x_1 = solver.get_state_values(1);
+  ASSERT_TRUE(acados::utils::shift_warm_start(solver, 0.05, interpolator, x_buffer, u_buffer));
+  x_0 = solver.get_state_values(0);
+  for (unsigned int i = 0; i < solver.nx(); i++) {
+    ASSERT_NEAR(x_0[i], x_1[i], 1e-9);
+  }
+  Eigen::VectorXd invalid_buffer(solver.nx() + 1);
+  ASSERT_FALSE(
+    acados::utils::shift_warm_start(solver, 0.05, interpolator, invalid_buffer, u_buffer));
+}
+
+TEST(TestCreateMockSolver, test_event_triggered_solver)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+  acados::ValueVector p {1.0, 0.1};
+  solver.set_runtime_parameters(p);
+
+  acados::EventTriggeredSolver::Options options;
+  options.x0_thresholds["p"] = {1e-3};
+  options.x0_thresholds["theta"] = {1e-3};
+  options.default_threshold = 1e-2;
+  options.max_skipped_solves = 2;
+  ASSERT_THROW(
+    acados::EventTriggeredSolver(solver, acados::EventTriggeredSolver::Options{{{"p", {1.0, 1.0}}}}),
+    std::invalid_argument);
+  acados::EventTriggeredSolver event_triggered_solver(solver, options);
+
+  // First tick: always solved
+  acados::ValueVector x0 {0.0, 3.14, 0.0, 0.0};
+  ASSERT_EQ(event_triggered_solver.solve(x0), ACADOS_SUCCESS);
+  ASSERT_FALSE(event_triggered_solver.last_solve_skipped());
+
+  // Measured state equal to the prediction: the plan is shifted
+  acados::ValueVector x_1 = solver.get_state_values(1);
+  acados::ValueVector u_1 = solver.get_control_values(1);
+  ASSERT_EQ(event_triggered_solver.solve(x_1), ACADOS_SUCCESS);
+  ASSERT_TRUE(event_triggered_solver.last_solve_skipped());
+  ASSERT_EQ(solver.get_control_values(0), u_1);
+
+  // Disturbed state: solved again
+  acados::ValueVector x_2 = solver.get_state_values(1);
+  x_2[0] += 0.1;
+  event_triggered_solver.solve(x_2);
+  ASSERT_FALSE(event_triggered_solver.last_solve_skipped());
+  ASSERT_NEAR(event_triggered_solver.prediction_error()[0], 0.1, 1e-9);
+
+  // Forced solve
+  event_triggered_solver.force_next_solve();
+  x_2 = solver.get_state_values(1);
+  event_triggered_solver.solve(x_2);
+  ASSERT_FALSE(event_triggered_solver.last_solve_skipped());
+  ASSERT_EQ(event_triggered_solver.num_solves(), 3u);
+  ASSERT_EQ(event_triggered_solver.num_skipped_solves(), 1u);
+}
+
+TEST(TestCreateMockSolver, test_solver_scheduler)
+{
+  ASSERT_THROW(acados::SolverScheduler({0, {}}), std::invalid_argument);
+  ASSERT_THROW(acados::SolverScheduler({2, {0}}), std::invalid_argument);
+
+  mock_acados_solver_test::MockAcadosSolver solver_1, solver_2;
+  ASSERT_EQ(solver_1.init(20, 0.05), 0);
+  ASSERT_EQ(solver_2.init(20, 0.05), 0);
+  acados::ValueVector p {1.0, 0.1};
+  acados::ValueVector x0 {0.0, 3.14, 0.0, 0.0};
+  solver_1.set_runtime_parameters(p);
+  solver_2.set_runtime_parameters(p);
+
+  acados::SolverScheduler scheduler({2, {}});
+  acados::SolverScheduler::TaskOptions task;
+  task.period = std::chrono::milliseconds(10);
+  task.before_solve = [&x0](acados::AcadosSolver & solver) {solver.set_initial_state_values(x0);};
+  scheduler.add_task(solver_1, task);
+  task.period = std::chrono::milliseconds(20);
+  task.offset = std::chrono::milliseconds(5);
+  ASSERT_EQ(scheduler.add_task(solver_2, task), 1u);
+  task.period = std::chrono::nanoseconds::zero();
+  ASSERT_THROW(scheduler.add_task(solver_2, task), std::invalid_argument);
+
+  scheduler.start();
+  ASSERT_TRUE(scheduler.is_running());
+  ASSERT_THROW(scheduler.add_task(solver_2, task), std::logic_error);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  scheduler.stop();
+  ASSERT_FALSE(scheduler.is_running());
+
+  for (size_t task_index = 0; task_index < scheduler.num_tasks(); task_index++) {
+    acados::SolverScheduler::TaskStats stats = scheduler.task_stats(task_index);
+    ASSERT_GT(stats.num_completed, 0u);
+    ASSERT_LE(stats.num_completed + stats.num_overruns, stats.num_releases);
+    ASSERT_EQ(stats.last_status, ACADOS_SUCCESS);
+    ASSERT_LE(stats.mean_response_time, stats.max_response_time);
+  }
+  ASSERT_GT(scheduler.task_stats(0).num_releases, scheduler.task_stats(1).num_releases);
+}
+
+TEST(TestCreateMockSolver, test_shared_memory_solver)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+  ASSERT_THROW(
+    acados::RemoteSolver("/acados_test_no_host", std::chrono::milliseconds(10)), std::runtime_error);
+  acados::ValueVector p {1.0, 0.1};
+  solver.set_runtime_parameters(p);
+
+  // Host (same process for the test)
+  auto host = std::make_unique<acados::SolverHost>(solver, "/acados_test_shared_memory_solver");
+  std::atomic<bool> stop_requested {false};
+  std::thread host_thread([&] {host->serve(stop_requested);});
+
+  // Client (only the parameters of stage 5 are set through the proxy)
+  acados::RemoteSolver remote_solver("/acados_test_shared_memory_solver");
+  ASSERT_EQ(remote_solver.nx(), solver.nx());
+  ASSERT_EQ(remote_solver.N(), solver.N());
+  ASSERT_TRUE(remote_solver.is_host_alive());
+  acados::ValueVector p_5 {1.2, 0.1};
+  acados::ValueVector x0 {0.0, 3.14, 0.0, 0.0};
+  remote_solver.set_runtime_parameters(5, p_5);
+  remote_solver.set_initial_state_values(x0);
+  ASSERT_THROW(remote_solver.set_initial_state_values(p), std::range_error);
+  int status = remote_solver.solve(std::chrono::seconds(5));
+
+  // Host shutdown
+  stop_requested = true;
+  host_thread.join();
+  ASSERT_EQ(status, ACADOS_SUCCESS);
+  ASSERT_EQ(host->num_requests(), 1u);
+  ASSERT_EQ(remote_solver.solve_stats().sqp_iter, solver.solve_stats().sqp_iter);
+  for (unsigned int stage = 0; stage <= solver.N(); stage++) {
+    ASSERT_EQ(remote_solver.get_state_values(stage), solver.get_state_values(stage));
+  }
+  ASSERT_EQ(remote_solver.get_control_values(0), solver.get_control_values(0));
+  ASSERT_EQ(solver.get_parameter_values(4), p);
+  ASSERT_EQ(solver.get_parameter_values(5), p_5);
+  host.reset();
+  ASSERT_FALSE(remote_solver.is_host_alive());
+  ASSERT_EQ(
+    remote_solver.solve(std::chrono::milliseconds(10)), acados::RemoteSolver::STATUS_HOST_DEAD);
+
+  // Host restart: the proxy reconnects and sends the values set so far again
+  mock_acados_solver_test::MockAcadosSolver new_solver;
+  ASSERT_EQ(new_solver.init(20, 0.05), 0);
+  acados::ValueVector p_default = new_solver.get_parameter_values(4);
+  host = std::make_unique<acados::SolverHost>(new_solver, "/acados_test_shared_memory_solver");
+  stop_requested = false;
+  host_thread = std::thread([&] {host->serve(stop_requested);});
+  status = remote_solver.solve(std::chrono::seconds(5));
+  ASSERT_TRUE(remote_solver.is_host_alive());
+  stop_requested = true;
+  host_thread.join();
+  ASSERT_EQ(status, ACADOS_SUCCESS);
+  ASSERT_EQ(host->num_requests(), 1u);
+  ASSERT_EQ(new_solver.get_parameter_values(4), p_default);
+  ASSERT_EQ(new_solver.get_parameter_values(5), p_5);
+  ASSERT_EQ(remote_solver.get_state_values(0), x0);
+}
+
+TEST(TestCreateMockSolver, test_closed_loop_benchmark)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  acados::ClosedLoopBenchmark::Options options;
+  options.num_steps = 10;
+  options.x0 = {{"p", {0.0}}, {"p_dot", {0.0}}, {"theta", {0.1}}, {"theta_dot", {0.0}}};
+  options.p = {{"mass_cart", {1.0}}, {"mass_ball", {0.1}}};
+  options.x_ref = {{"theta", {0.0}}};
+  options.x_weights = {{"p", {1.0}}};
+  options.deadline = 1.0;
+  ASSERT_THROW(
+    acados::ClosedLoopBenchmark(solver, acados::ClosedLoopBenchmark::Options()),
+    std::invalid_argument);
+  acados::ClosedLoopBenchmark::Options invalid_options = options;
+  invalid_options.x_ref = {{"unknown", {0.0}}};
+  ASSERT_THROW(acados::ClosedLoopBenchmark(solver, invalid_options), std::invalid_argument);
+
+  acados::ClosedLoopBenchmark benchmark(solver, options);
+  ASSERT_EQ(benchmark.run(), 0);
+  ASSERT_EQ(benchmark.records().size(), options.num_steps);
+  const acados::ClosedLoopBenchmark::Summary & summary = benchmark.summary();
+  ASSERT_EQ(summary.num_steps, options.num_steps);
+  ASSERT_EQ(summary.num_failures, 0u);
+  ASSERT_EQ(summary.num_deadline_misses, 0u);
+  ASSERT_LE(summary.solve_time_min, summary.solve_time_p50);
+  ASSERT_LE(summary.solve_time_p50, summary.solve_time_p99);
+  ASSERT_LE(summary.solve_time_p99, summary.solve_time_max);
+  ASSERT_DOUBLE_EQ(benchmark.records()[0].stage_cost, 0.1 * 0.1);
+  ASSERT_GT(summary.tracking_cost, 0.0);
+
+  std::stringstream csv, json;
+  benchmark.write_csv(csv);
+  benchmark.write_json(json);
+  ASSERT_EQ(csv.precision(), std::stringstream().precision());  // Format of the caller restored
+  ASSERT_EQ(json.precision(), std::stringstream().precision());
+  std::string csv_header;
+  std::getline(csv, csv_header);
+  ASSERT_NE(csv_header.find("x_theta"), std::string::npos);
+  ASSERT_NE(csv_header.find("u_f"), std::string::npos);
+  ASSERT_NE(json.str().find("\"tracking_cost\""), std::string::npos);
+  ASSERT_NE(
+    json.str().find("\"parameters\": {\"mass_cart\": 1, \"mass_ball\": 0.1}"), std::string::npos);
+}
+
+TEST(TestCreateMockSolver, test_dataset_generator)
+{
+  auto solver_factory = []() {
+      auto solver = std::make_shared<mock_acados_solver_test::MockAcadosSolver>();
+      solver->init(20, 0.05);
+      acados::ValueVector p {1.0, 0.2};
+      solver->set_runtime_parameters(p);
+      return solver;
+    };
+  acados::DatasetGenerator::Options options;
+  options.num_samples = 20;
+  options.num_threads = 2;
+  options.x0_lower = {{"theta", {-0.1}}};
+  options.x0_upper = {{"theta", {0.1}}};
+  options.p_lower = {{"mass_cart", {1.0}}};  // "mass_ball" keeps the value set by the factory
+  options.p_upper = {{"mass_cart", {2.0}}};
+  options.store_trajectories = true;
+  acados::DatasetGenerator::Options invalid_options = options;
+  invalid_options.x0_upper = {{"theta", {-0.2}}};
+  ASSERT_THROW(acados::DatasetGenerator(solver_factory, invalid_options), std::invalid_argument);
+
+  const std::string path = "/tmp/acados_test_dataset.bin";
+  acados::DatasetGenerator generator(solver_factory, options);
+  acados::DatasetGenerator::Summary summary = generator.generate(path);
+  ASSERT_EQ(summary.num_samples, options.num_samples);
+  ASSERT_EQ(summary.num_failures, 0u);
+
+  acados::DatasetReader reader(path);
+  ASSERT_EQ(reader.num_samples(), options.num_samples);
+  ASSERT_TRUE(reader.has_column("u_traj"));
+  ASSERT_THROW(reader.column("unknown"), std::invalid_argument);
+  acados::DatasetReader::ColumnMap x0 = reader.column("x0");
+  acados::DatasetReader::ColumnMap p = reader.column("p");
+  acados::DatasetReader::ColumnMap x_traj = reader.column("x_traj");
+  ASSERT_EQ(x0.cols(), 4);
+  ASSERT_EQ(x_traj.cols(), 21 * 4);
+  for (size_t i = 0; i < reader.num_samples(); i++) {
+    ASSERT_EQ(x0(i, 0), 0.0);
+    ASSERT_LE(std::abs(x0(i, 2)), 0.1);
+    ASSERT_GE(p(i, 0), 1.0);
+    ASSERT_LE(p(i, 0), 2.0);
+    ASSERT_EQ(p(i, 1), 0.2);
+    ASSERT_EQ(reader.column("status")(i, 0), ACADOS_SUCCESS);
+    ASSERT_LT((x_traj.row(i).head(4) - x0.row(i)).cwiseAbs().maxCoeff(), 1e-6);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(TestCreateMockSolver, test_mppi_controller)
+{
+  auto solver_factory = []() {
+      auto solver = std::make_shared<mock_acados_solver_test::MockAcadosSolver>();
+      solver->init(20, 0.05);
+      return solver;
+    };
+  acados::MppiController::Options options;
+  options.num_samples = 256;
+  options.num_threads = 4;
+  options.lambda = 0.1;
+  options.noise_std = {{"f", {5.0}}};
+  options.u_lower = {{"f", {-20.0}}};
+  options.u_upper = {{"f", {20.0}}};
+  options.x_ref = {{"p", {0.2}}};
+  options.u_weights = {{"f", {1e-4}}};
+  acados::MppiController::Options invalid_options = options;
+  invalid_options.u_upper = {{"f", {-30.0}}};
+  ASSERT_THROW(acados::MppiController(solver_factory, invalid_options), std::invalid_argument);
+
+  acados::MppiController mppi(solver_factory, options);
+  ASSERT_EQ(mppi.num_threads(), 4u);
+  ASSERT_THROW(mppi.set_runtime_parameters({1.0}), std::invalid_argument);
+  mppi.set_runtime_parameters({1.0, 0.1});
+  acados::ValueVector x0 {0.0, 0.0, 0.0, 0.0};
+  ASSERT_EQ(mppi.solve(x0), 0);
+  const double first_min_cost = mppi.min_cost();
+  for (int iteration = 0; iteration < 10; iteration++) {
+    ASSERT_EQ(mppi.solve(x0), 0);
+  }
+  ASSERT_LE(mppi.min_cost(), first_min_cost);
+  ASSERT_GE(mppi.effective_sample_size(), 1.0);
+  ASSERT_LE(mppi.control_trajectory().cwiseAbs().maxCoeff(), 20.0);
+  ASSERT_EQ(mppi.state_trajectory().cols(), 21);
+  ASSERT_EQ(mppi.state_trajectory().col(0)[0], 0.0);
+
+  // Warm start of the OCP solver
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+  mppi.warm_start(solver);
+  acados::ValueVector u_1 = solver.get_control_values(1);
+  ASSERT_DOUBLE_EQ(u_1[0], mppi.control_trajectory()(0, 1));
+  mppi.shift();
+  ASSERT_DOUBLE_EQ(mppi.control_trajectory()(0, 0), u_1[0]);
+}
+
+TEST(TestCreateMockSolver, test_simulate_with_sensitivities)
+{
+  mock_acados_solver_test::MockAcadosSolver solver;
+  ASSERT_EQ(solver.init(20, 0.05), 0);
+
+  const double dt = 0.01;
+  acados::ValueVector x0 {0.1, 0.0, 0.2, 0.0};
+  acados::ValueVector u0 {1.0};
+  acados::ValueVector p {1.0, 0.1};
+  acados::ValueVector x_next(solver.nx()), z(solver.nz());
+  acados::ColumnMajorXd dx_next_dx0(solver.nx(), solver.nx());
+  acados::ColumnMajorXd dx_next_du(solver.nx(), solver.nu());
+  ASSERT_EQ(
+    solver.simulate_with_sensitivities(dt, x0, u0, p, x_next, z, dx_next_dx0, dx_next_du), 0);
+
+  // Consistency with simulate()
+  acados::ValueVector x_next_ref(solver.nx()), z_ref(solver.nz());
+  ASSERT_EQ(solver.simulate(dt, x0, u0, p, x_next_ref, z_ref), 0);
+  for (unsigned int i = 0; i < solver.nx(); i++) {
+    ASSERT_NEAR(x_next[i], x_next_ref[i], 1e-9);
+  }
+
+  // Comparison with central finite differences
+  const double eps = 1e-6;
+  acados::ValueVector x_plus(solver.nx()), x_minus(solver.nx());
+  for (unsigned int j = 0; j < solver.nx(); j++) {
+    acados::ValueVector x0_perturbed = x0;
+    x0_perturbed[j] = x0[j] + eps;
+    ASSERT_EQ(solver.simulate(dt, x0_perturbed, u0, p, x_plus, z_ref), 0);
+    x0_perturbed[j] = x0[j] - eps;
+    ASSERT_EQ(solver.simulate(dt, x0_perturbed, u0, p, x_minus, z_ref), 0);
+    for (unsigned int i = 0; i < solver.nx(); i++) {
+      ASSERT_NEAR(dx_next_dx0(i, j), (x_plus[i] - x_minus[i]) / (2 * eps), 1e-5);
+    }
+  }
+  acados::ValueVector u0_perturbed = u0;
+  u0_perturbed[0] = u0[0] + eps;
+  ASSERT_EQ(solver.simulate(dt, x0, u0_perturbed, p, x_plus, z_ref), 0);
+  u0_perturbed[0] = u0[0] - eps;
+  ASSERT_EQ(solver.simulate(dt, x0, u0_perturbed, p, x_minus, z_ref), 0);
+  for (unsigned int i = 0; i < solver.nx(); i++) {
+    ASSERT_NEAR(dx_next_du(i, 0), (x_plus[i] - x_minus[i]) / (2 * eps), 1e-5);
+  }
+
+  // Invalid output sizes
+  acados::ColumnMajorXd invalid_matrix(solver.nx(), solver.nx() + solver.nu());
+  ASSERT_EQ(
+    solver.simulate_with_sensitivities(dt, x0, u0, p, x_next, z, invalid_matrix, dx_next_du), 12);
+}
@@ -72,3 +72,23 @@ TEST(TestStaticFunctions, test_is_values_map_complete)
   ASSERT_EQ(acados::AcadosSolver::is_values_map_complete(index_map, incomplete_value_map_1), false);
   ASSERT_EQ(acados::AcadosSolver::is_values_map_complete(index_map, incomplete_value_map_2), false);
 }
+TEST(TestStaticFunctions, test_flat_index_map)
+{
+  acados::IndexMap index_map {{"a", {0, 1, 2}}, {"b", {5}}, {"c", {4, 3}}};
+  acados::FlatIndexMap flat_index_map(index_map);
+  ASSERT_EQ(flat_index_map.num_keys(), 3u);
+  ASSERT_EQ(flat_index_map.total_size(), 6u);
+  ASSERT_EQ(flat_index_map.find("d"), acados::FlatIndexMap::npos);
+  ASSERT_TRUE(flat_index_map.is_contiguous(flat_index_map.find("a")));
+  ASSERT_FALSE(flat_index_map.is_contiguous(flat_index_map.find("c")));
+
+  // Same behavior as the IndexMap based utils
+  std::vector<double> values {1.0, 2.0, 4.0, 3.0, 5.0, 6.0};
+  acados::ValueMap value_map;
+  flat_index_map.fill_map_from_values(values.data(), value_map);
+  ASSERT_EQ(value_map, acados::AcadosSolver::create_map_from_values(index_map, values));
+
+  std::vector<double> new_values(values.size(), 0.0);
+  flat_index_map.fill_vector_from_map(value_map, new_values.data());
+  ASSERT_EQ(new_values, values);
+}
@@ -2,14 +2,7 @@
 # License: Apache License, Version 2.0
 # Author: Thibault Poignonec (tpoignonec@unistra.fr)
 
-# from acados_template import AcadosOcp, AcadosOcpSolver
-# from acados_template import  ocp_get_default_cmake_builder
-# import casadi as ca
-
-# from copy import deepcopy
-# import os
-
-# from acados_solver_plugins.utils import uppercase_to_underscore
+import os
 
 # Plugin loader
 
@@ -23,16 +16,69 @@ class SolverPluginLoader:
         """
         Solver plugin loader constructor.
 
-        :param custom_import_path: Dir where the generated files were \
-            exported by the generator, defaults to None
+        The plugins are loaded through pluginlib (i.e., the same C++ shared \
+        libraries as the ones loaded by ROS 2 nodes and controllers) and \
+        are exposed through NumPy views on preallocated buffers.
+
+        :param custom_import_path: Install prefix of the library that the \
+            generated plugins were built in, if it is not already part of \
+            the sourced workspace, defaults to None
         :type custom_import_path: str, optional
         :param library_name: Name of the library that the generated files \
             are part of, defaults to None (in which case the library \
             is set to "acados_solver_plugins" internally)
         :type library_name: str, optional
         """
-        raise NotImplementedError('TODO')
+        self.custom_import_path = custom_import_path
+        self.library_name = library_name or 'acados_solver_plugins'
+        if self.custom_import_path is not None:
+            # pluginlib resolves the plugin description files from the ament index
+            prefix_path = os.environ.get('AMENT_PREFIX_PATH', '')
+            if self.custom_import_path not in prefix_path.split(os.pathsep):
+                os.environ['AMENT_PREFIX_PATH'] = os.pathsep.join(
+                    filter(None, [self.custom_import_path, prefix_path]))
+        # Imported here so that the generator can be used without the compiled bindings
+        from acados_solver_plugins._acados_solver_plugins_py import PluginlibLoader
+        self._loader = PluginlibLoader()
+
+    def declared_solver_plugins(self):
+        """Return the names of the declared solver plugins (all libraries)."""
+        return self._loader.declared_classes()
+
+    def load_solver_plugin(
+        self,
+        solver_plugin_name: str,
+        N: int = None,
+        Ts: float = None
+    ):
+        """
+        Load a Acados OCP solver from previously exported plugin.
 
-    def load_solver_plugin(self, solver_plugin_name: str):
-        """Load a Acados OCP solver from previously exported plugin. TODO."""
-        raise NotImplementedError('TODO')
+        The returned solver exposes the dimensions (`nx`, `nu`, `np`, `N`, ...), \
+        the index maps, the setters (`set_initial_state()`, \
+        `set_runtime_parameters()`, ...), `solve()`, `solve_stats()`, and \
+        `simulate()`. The solution is exposed without copy through the \
+        `x_traj` (shape (N+1, nx)) and `u_traj` (shape (N, nu)) views, \
+        refreshed by each call to `solve()`.
+
+        :param solver_plugin_name: Name of the plugin, either the class name \
+            (e.g., "MyAcadosSolver") or the full name \
+            (e.g., "acados_solver_plugins/MyAcadosSolver")
+        :type solver_plugin_name: str
+        :param N: Number of shooting nodes, defaults to None (i.e., not initialized)
+        :type N: int, optional
+        :param Ts: Sampling period, defaults to None (i.e., not initialized)
+        :type Ts: float, optional
+        :raises RuntimeError: if the plugin cannot be loaded or initialized
+        :return: Solver instance
+        """
+        if '/' not in solver_plugin_name:
+            solver_plugin_name = f'{self.library_name}/{solver_plugin_name}'
+        solver = self._loader.create_instance(solver_plugin_name)
+        if N is not None and Ts is not None:
+            status = solver.init(N, Ts)
+            if status != 0:
+                raise RuntimeError(
+                    f'Failed to initialize the solver plugin "{solver_plugin_name}" '
+                    f'(status {status})!')
+        return solver
@@ -0,0 +1,181 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+// Closed-loop benchmark: loads an AcadosSolver plugin and runs a closed-loop simulation using the
+// embedded sim solver as plant (see `acados::ClosedLoopBenchmark`).
+//
+// Usage: acados_closed_loop_bench <plugin_name> <N> <Ts> [options]
+//   --steps K               Number of closed-loop steps (default: 100)
+//   --x0 key=v1[,v2...]     Initial state (repeatable, zero for the missing keys)
+//   --p key=v1[,v2...]      Runtime parameters (repeatable, plugin defaults for the missing keys)
+//   --x-ref key=v1[,v2...]  Tracked state reference (repeatable)
+//   --x-weight key=v1[,...] State tracking weights (repeatable)
+//   --u-weight key=v1[,...] Control effort weights (repeatable)
+//   --deadline s            Deadline of each solve in seconds (default: Ts)
+//   --rti                   Use the RTI scheme (only the feedback phase is timed)
+//   --csv path              Write the per-step records as CSV
+//   --json path             Write the summary, the parameters, and the records as JSON
+//
+//   e.g. acados_closed_loop_bench acados_solver_plugins_example/MockAcadosSolver 20 0.05
+//          --steps 500 --x0 theta=0.1 --p mass_cart=1.0 --p mass_ball=0.1 --x-ref theta=0.0
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <pluginlib/class_loader.hpp>
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_solver_base/closed_loop_benchmark.hpp"
+
+namespace
+{
+
+/// @brief Parse "key=v1,v2,..." into `values_map`.
+void parse_map_entry(std::string const & argument, acados::ValueMap & values_map)
+{
+  const size_t separator = argument.find('=');
+  if (separator == std::string::npos || separator == 0) {
+    throw std::invalid_argument("invalid entry '" + argument + "' (expected key=v1[,v2...])");
+  }
+  acados::ValueVector values;
+  std::stringstream values_stream(argument.substr(separator + 1));
+  std::string value;
+  while (std::getline(values_stream, value, ',')) {
+    values.push_back(std::stod(value));
+  }
+  values_map[argument.substr(0, separator)] = values;
+}
+
+/// @brief Complete the map with the default values of the missing keys of the index map.
+void complete_with_defaults(
+  acados::IndexMap const & index_map,
+  acados::ValueVector const & default_values,
+  acados::ValueMap & values_map)
+{
+  for (auto const & [key, indexes] : index_map) {
+    if (values_map.find(key) == values_map.end()) {
+      acados::ValueVector & values = values_map[key];
+      for (unsigned int index : indexes) {
+        values.push_back(default_values[index]);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  if (argc < 4) {
+    std::cerr << "Usage: " << argv[0] << " <plugin_name> <N> <Ts> [--steps K] "
+              << "[--x0 key=v1[,v2...]] [--p key=...] [--x-ref key=...] [--x-weight key=...] "
+              << "[--u-weight key=...] [--deadline s] [--rti] [--csv path] [--json path]"
+              << std::endl;
+    return 1;
+  }
+  const std::string solver_plugin_name = argv[1];
+  std::string csv_path, json_path;
+
+  try {
+    const unsigned int N = static_cast<unsigned int>(std::stoul(argv[2]));
+    const double Ts = std::stod(argv[3]);
+    acados::ClosedLoopBenchmark::Options options;
+    for (int i = 4; i < argc; i++) {
+      const std::string argument = argv[i];
+      if (argument == "--rti") {
+        options.use_rti = true;
+        continue;
+      }
+      if (i + 1 >= argc) {
+        throw std::invalid_argument("missing value of '" + argument + "'");
+      }
+      const std::string value = argv[++i];
+      if (argument == "--steps") {
+        options.num_steps = static_cast<unsigned int>(std::stoul(value));
+      } else if (argument == "--x0") {
+        parse_map_entry(value, options.x0);
+      } else if (argument == "--p") {
+        parse_map_entry(value, options.p);
+      } else if (argument == "--x-ref") {
+        parse_map_entry(value, options.x_ref);
+      } else if (argument == "--x-weight") {
+        parse_map_entry(value, options.x_weights);
+      } else if (argument == "--u-weight") {
+        parse_map_entry(value, options.u_weights);
+      } else if (argument == "--deadline") {
+        options.deadline = std::stod(value);
+      } else if (argument == "--csv") {
+        csv_path = value;
+      } else if (argument == "--json") {
+        json_path = value;
+      } else {
+        throw std::invalid_argument("unknown option '" + argument + "'");
+      }
+    }
+
+    pluginlib::ClassLoader<acados::AcadosSolver> acados_solver_loader("acados_solver_base",
+      "acados::AcadosSolver");
+    std::shared_ptr<acados::AcadosSolver> solver = acados_solver_loader.createSharedInstance(
+      solver_plugin_name);
+    if (solver->init(N, Ts) != 0) {
+      std::cerr << "Failed to initialize the solver plugin \"" << solver_plugin_name << "\"!"
+                << std::endl;
+      return 1;
+    }
+    // Missing initial states are set to zero, missing parameters keep the values of the plugin
+    complete_with_defaults(
+      solver->x_index_map(), acados::ValueVector(solver->nx(), 0.0), options.x0);
+    complete_with_defaults(solver->p_index_map(), solver->get_parameter_values(0), options.p);
+
+    acados::ClosedLoopBenchmark benchmark(*solver, options);
+    int status = benchmark.run();
+    if (status != 0) {
+      std::cerr << "Plant simulation failed (status " << status << ") after "
+                << benchmark.records().size() << " steps!" << std::endl;
+    }
+
+    const acados::ClosedLoopBenchmark::Summary & summary = benchmark.summary();
+    std::cout << "Closed-loop benchmark of \"" << solver_plugin_name << "\" (" << summary.num_steps
+              << " steps" << (options.use_rti ? ", RTI" : "") << ")\n"
+              << "  solve time [ms]: min " << 1e3 * summary.solve_time_min
+              << ", mean " << 1e3 * summary.solve_time_mean
+              << ", p50 " << 1e3 * summary.solve_time_p50
+              << ", p95 " << 1e3 * summary.solve_time_p95
+              << ", p99 " << 1e3 * summary.solve_time_p99
+              << ", max " << 1e3 * summary.solve_time_max << "\n"
+              << "  sqp iterations: mean " << summary.sqp_iter_mean
+              << ", max " << summary.sqp_iter_max << "\n"
+              << "  failures: " << summary.num_failures
+              << ", deadline misses: " << summary.num_deadline_misses << "\n"
+              << "  tracking cost: " << summary.tracking_cost << std::endl;
+
+    if (!csv_path.empty()) {
+      std::ofstream csv_file(csv_path);
+      benchmark.write_csv(csv_file);
+    }
+    if (!json_path.empty()) {
+      std::ofstream json_file(json_path);
+      benchmark.write_json(json_file);
+    }
+    return (status == 0) ? 0 : 1;
+  } catch (std::exception const & e) {
+    std::cerr << "acados_closed_loop_bench: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,78 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+// Out-of-process solver host: loads an AcadosSolver plugin and serves the solve requests
+// of an `acados::RemoteSolver` through a shared-memory segment.
+//
+// Usage: acados_solver_host <plugin_name> <channel_name> <N> <Ts>
+//   e.g. acados_solver_host acados_solver_plugins_example/MockAcadosSolver /mock_solver 20 0.05
+
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <pluginlib/class_loader.hpp>
+#include "acados_solver_base/acados_solver.hpp"
+#include "acados_solver_base/shared_memory_solver.hpp"
+
+namespace
+{
+std::atomic<bool> g_stop_requested {false};
+
+void signal_handler(int /*signal*/)
+{
+  g_stop_requested = true;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  if (argc != 5) {
+    std::cerr << "Usage: " << argv[0] << " <plugin_name> <channel_name> <N> <Ts>" << std::endl;
+    return 1;
+  }
+  const std::string solver_plugin_name = argv[1];
+  const std::string channel_name = argv[2];
+  const unsigned int N = static_cast<unsigned int>(std::stoul(argv[3]));
+  const double Ts = std::stod(argv[4]);
+
+  std::signal(SIGINT, signal_handler);
+  std::signal(SIGTERM, signal_handler);
+
+  try {
+    pluginlib::ClassLoader<acados::AcadosSolver> acados_solver_loader("acados_solver_base",
+      "acados::AcadosSolver");
+    std::shared_ptr<acados::AcadosSolver> solver = acados_solver_loader.createSharedInstance(
+      solver_plugin_name);
+    if (solver->init(N, Ts) != 0) {
+      std::cerr << "Failed to initialize the solver plugin \"" << solver_plugin_name << "\"!"
+                << std::endl;
+      return 1;
+    }
+
+    acados::SolverHost host(*solver, channel_name);
+    std::cout << "Serving \"" << solver_plugin_name << "\" on \"" << channel_name << "\"..."
+              << std::endl;
+    host.serve(g_stop_requested);
+    std::cout << "Served " << host.num_requests() << " requests." << std::endl;
+  } catch (std::exception const & e) {
+    std::cerr << "acados_solver_host: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
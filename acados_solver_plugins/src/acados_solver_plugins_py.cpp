@@ -0,0 +1,296 @@
+// Copyright 2023 ICUBE Laboratory, University of Strasbourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+// Python bindings of the `acados::AcadosSolver` plugins (see `solver_plugin_loader.py`).
+//
+// The solver data is exchanged through buffers allocated once by `init()`, exposed as NumPy views
+// (i.e., no copy between Python and C++ besides the copies from/to the Acados C-interface).
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pluginlib/class_loader.hpp>
+#include "acados_solver_base/acados_solver.hpp"
+
+namespace py = pybind11;
+
+namespace
+{
+
+using SolverLoader = pluginlib::ClassLoader<acados::AcadosSolver>;
+
+class PySolver
+{
+public:
+  PySolver(std::shared_ptr<SolverLoader> loader, std::shared_ptr<acados::AcadosSolver> solver)
+  : _loader(loader), _solver(solver)
+  {
+  }
+
+  int init(unsigned int N, double Ts)
+  {
+    int status = _solver->init(N, Ts);
+    if (status != 0) {
+      return status;
+    }
+    _x0 = Eigen::VectorXd::Zero(nx());
+    _x_traj = acados::ColumnMajorXd::Zero(nx(), N + 1);
+    _u_traj = acados::ColumnMajorXd::Zero(nu(), N);
+    _sim_x0.assign(nx(), 0.0);
+    _sim_u0.assign(nu(), 0.0);
+    _sim_p.assign(np(), 0.0);
+    _sim_x_next.assign(nx(), 0.0);
+    _sim_z.assign(nz(), 0.0);  // Empty if nz = 0 (null data, accepted by simulate())
+    return 0;
+  }
+
+  unsigned int nx() const {return _solver->nx();}
+  unsigned int nz() const {return _solver->nz();}
+  unsigned int np() const {return _solver->np();}
+  unsigned int nu() const {return _solver->nu();}
+  unsigned int N() const {return _solver->N();}
+  double Ts() const {return _solver->Ts();}
+
+  // Views on the preallocated buffers (column-major for the trajectories, rows = stages)
+
+  py::array_t<double> view(double * data, py::ssize_t size, py::handle base)
+  {
+    check_initialized();
+    return py::array_t<double>({size}, data, base);
+  }
+
+  py::array_t<double> view(double * data, py::ssize_t rows, py::ssize_t cols, py::handle base)
+  {
+    check_initialized();
+    return py::array_t<double>(
+      {rows, cols},
+      {static_cast<py::ssize_t>(sizeof(double)) * cols, static_cast<py::ssize_t>(sizeof(double))},
+      data, base);
+  }
+
+  // Setters (from any array-like object, cast without copy if already a C-contiguous float64 array)
+
+  int set_initial_state(py::array_t<double, py::array::c_style | py::array::forcecast> x0)
+  {
+    check_initialized();
+    check_size(x0, nx(), "x0");
+    std::memcpy(_x0.data(), x0.data(), sizeof(double) * nx());
+    _solver->set_initial_state_values_unchecked(_x0.data());
+    return 0;
+  }
+
+  int set_runtime_parameters(py::array_t<double, py::array::c_style | py::array::forcecast> p)
+  {
+    check_initialized();
+    if (p.ndim() == 1) {
+      check_size(p, np(), "p");
+      for (unsigned int stage = 0; stage <= N(); stage++) {
+        _solver->set_runtime_parameters_unchecked(stage, p.data());
+      }
+      return 0;
+    }
+    if (p.ndim() != 2 || p.shape(0) != N() + 1 || p.shape(1) != np()) {
+      throw std::invalid_argument("The runtime parameters must be of shape (np,) or (N+1, np)!");
+    }
+    for (unsigned int stage = 0; stage <= N(); stage++) {
+      _solver->set_runtime_parameters_unchecked(stage, p.data(stage, 0));
+    }
+    return 0;
+  }
+
+  int initialize_state_trajectory(
+    py::array_t<double, py::array::c_style | py::array::forcecast> x_traj)
+  {
+    check_initialized();
+    if (x_traj.ndim() != 2 || x_traj.shape(0) != N() + 1 || x_traj.shape(1) != nx()) {
+      throw std::invalid_argument("The state trajectory must be of shape (N+1, nx)!");
+    }
+    for (unsigned int stage = 0; stage <= N(); stage++) {
+      _solver->initialize_state_values_unchecked(stage, x_traj.data(stage, 0));
+    }
+    return 0;
+  }
+
+  int initialize_control_trajectory(
+    py::array_t<double, py::array::c_style | py::array::forcecast> u_traj)
+  {
+    check_initialized();
+    if (u_traj.ndim() != 2 || u_traj.shape(0) != N() || u_traj.shape(1) != nu()) {
+      throw std::invalid_argument("The control trajectory must be of shape (N, nu)!");
+    }
+    for (unsigned int stage = 0; stage < N(); stage++) {
+      _solver->initialize_control_values_unchecked(stage, u_traj.data(stage, 0));
+    }
+    return 0;
+  }
+
+  // Solve
+
+  int solve()
+  {
+    check_initialized();
+    int status;
+    {
+      py::gil_scoped_release release;
+      status = _solver->solve();
+    }
+    update_trajectories();
+    return status;
+  }
+
+  void update_trajectories()
+  {
+    for (unsigned int stage = 0; stage <= N(); stage++) {
+      _solver->get_state_values_unchecked(stage, _x_traj.col(stage).data());
+    }
+    for (unsigned int stage = 0; stage < N(); stage++) {
+      _solver->get_control_values_unchecked(stage, _u_traj.col(stage).data());
+    }
+  }
+
+  py::dict solve_stats() const
+  {
+    const acados::AcadosSolver::SolveStats & stats = _solver->solve_stats();
+    py::dict stats_dict;
+    stats_dict["status"] = stats.status;
+    stats_dict["time_tot"] = stats.time_tot;
+    stats_dict["time_lin"] = stats.time_lin;
+    stats_dict["time_qp"] = stats.time_qp;
+    stats_dict["time_reg"] = stats.time_reg;
+    stats_dict["sqp_iter"] = stats.sqp_iter;
+    stats_dict["qp_iter"] = stats.qp_iter;
+    stats_dict["res_stat"] = stats.res_stat;
+    stats_dict["res_eq"] = stats.res_eq;
+    stats_dict["res_ineq"] = stats.res_ineq;
+    stats_dict["res_comp"] = stats.res_comp;
+    return stats_dict;
+  }
+
+  // Simulation
+
+  int simulate(
+    double dt,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x0,
+    py::array_t<double, py::array::c_style | py::array::forcecast> u0,
+    py::array_t<double, py::array::c_style | py::array::forcecast> p)
+  {
+    check_initialized();
+    check_size(x0, nx(), "x0");
+    check_size(u0, nu(), "u0");
+    check_size(p, np(), "p");
+    std::memcpy(_sim_x0.data(), x0.data(), sizeof(double) * nx());
+    std::memcpy(_sim_u0.data(), u0.data(), sizeof(double) * nu());
+    std::memcpy(_sim_p.data(), p.data(), sizeof(double) * np());
+    return _solver->simulate(dt, _sim_x0, _sim_u0, _sim_p, _sim_x_next, _sim_z);
+  }
+
+  std::shared_ptr<SolverLoader> _loader;  // Must outlive the solver
+  std::shared_ptr<acados::AcadosSolver> _solver;
+
+  Eigen::VectorXd _x0;
+  acados::ColumnMajorXd _x_traj, _u_traj;
+  acados::ValueVector _sim_x0, _sim_u0, _sim_p, _sim_x_next, _sim_z;
+
+private:
+  void check_initialized() const
+  {
+    if (_x_traj.size() == 0) {
+      throw std::runtime_error("The solver is not initialized, call init(N, Ts) first!");
+    }
+  }
+
+  static void check_size(py::array const & values, unsigned int size, const char * name)
+  {
+    if (values.ndim() != 1 || values.shape(0) != size) {
+      throw std::invalid_argument(std::string("Invalid size of '") + name + "'!");
+    }
+  }
+};
+
+}  // namespace
+
+PYBIND11_MODULE(_acados_solver_plugins_py, m)
+{
+  m.doc() = "Python bindings of the acados::AcadosSolver plugins (pluginlib).";
+
+  py::class_<SolverLoader, std::shared_ptr<SolverLoader>>(m, "PluginlibLoader")
+  .def(py::init([]() {
+      return std::make_shared<SolverLoader>("acados_solver_base", "acados::AcadosSolver");
+    }))
+  .def("declared_classes", &SolverLoader::getDeclaredClasses)
+  .def(
+    "create_instance",
+    [](std::shared_ptr<SolverLoader> loader, std::string const & plugin_name) {
+      try {
+        return std::make_shared<PySolver>(loader, loader->createSharedInstance(plugin_name));
+      } catch (pluginlib::PluginlibException & ex) {
+        throw std::runtime_error(
+          "Failed to load the solver plugin '" + plugin_name + "': " + ex.what());
+      }
+    },
+    py::arg("plugin_name"));
+
+  py::class_<PySolver, std::shared_ptr<PySolver>>(m, "AcadosSolver")
+  .def("init", &PySolver::init, py::arg("N"), py::arg("Ts"))
+  .def_property_readonly("nx", &PySolver::nx)
+  .def_property_readonly("nz", &PySolver::nz)
+  .def_property_readonly("np", &PySolver::np)
+  .def_property_readonly("nu", &PySolver::nu)
+  .def_property_readonly("N", &PySolver::N)
+  .def_property_readonly("Ts", &PySolver::Ts)
+  .def_property_readonly(
+    "x_index_map", [](PySolver & self) {return self._solver->x_index_map();})
+  .def_property_readonly(
+    "z_index_map", [](PySolver & self) {return self._solver->z_index_map();})
+  .def_property_readonly(
+    "p_index_map", [](PySolver & self) {return self._solver->p_index_map();})
+  .def_property_readonly(
+    "u_index_map", [](PySolver & self) {return self._solver->u_index_map();})
+  .def_property_readonly(
+    "sampling_intervals", [](PySolver & self) {return self._solver->sampling_intervals();})
+  .def("set_initial_state", &PySolver::set_initial_state, py::arg("x0"))
+  .def("set_runtime_parameters", &PySolver::set_runtime_parameters, py::arg("p"))
+  .def("initialize_state_trajectory", &PySolver::initialize_state_trajectory, py::arg("x_traj"))
+  .def(
+    "initialize_control_trajectory", &PySolver::initialize_control_trajectory, py::arg("u_traj"))
+  .def("solve", &PySolver::solve)
+  .def("reset", [](PySolver & self) {return self._solver->reset();})
+  .def("solve_stats", &PySolver::solve_stats)
+  .def("simulate", &PySolver::simulate, py::arg("dt"), py::arg("x0"), py::arg("u0"), py::arg("p"))
+  // Views (refreshed by `solve()` / `simulate()`, the arrays keep the solver alive)
+  .def_property_readonly(
+    "x_traj", [](py::object self_obj) {
+      PySolver & self = self_obj.cast<PySolver &>();
+      return self.view(self._x_traj.data(), self.N() + 1, self.nx(), self_obj);
+    })
+  .def_property_readonly(
+    "u_traj", [](py::object self_obj) {
+      PySolver & self = self_obj.cast<PySolver &>();
+      return self.view(self._u_traj.data(), self.N(), self.nu(), self_obj);
+    })
+  .def_property_readonly(
+    "x_next", [](py::object self_obj) {
+      PySolver & self = self_obj.cast<PySolver &>();
+      return self.view(self._sim_x_next.data(), self.nx(), self_obj);
+    });
+}
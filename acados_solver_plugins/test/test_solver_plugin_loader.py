@@ -0,0 +1,56 @@
+# Copyright 2023 ICUBE Laboratory, University of Strasbourg
+# License: Apache License, Version 2.0
+# Author: Thibault Poignonec (tpoignonec@unistra.fr)
+
+from acados_solver_plugins import SolverPluginLoader
+import numpy as np
+import pytest
+
+# Mock solver plugin registered in the build tree of "acados_solver_base" (pendulum on a cart)
+MOCK_SOLVER_PLUGIN = 'acados_solver_base/MockAcadosSolver'
+
+
+@pytest.fixture
+def loader():
+    return SolverPluginLoader()
+
+
+def test_declared_solver_plugins(loader):
+    assert MOCK_SOLVER_PLUGIN in loader.declared_solver_plugins()
+
+
+def test_uninitialized_solver(loader):
+    solver = loader.load_solver_plugin(MOCK_SOLVER_PLUGIN)
+    for view in ['x_traj', 'u_traj', 'x_next']:
+        with pytest.raises(RuntimeError):
+            getattr(solver, view)
+
+
+def test_solve(loader):
+    solver = loader.load_solver_plugin(MOCK_SOLVER_PLUGIN, N=20, Ts=0.05)
+    assert (solver.nx, solver.nu, solver.np, solver.N) == (4, 1, 2, 20)
+
+    solver.set_runtime_parameters([1.0, 0.1])
+    solver.set_initial_state([0.0, 0.0, 0.1, 0.0])
+    assert solver.solve() == 0
+    x_traj = solver.x_traj
+    u_traj = solver.u_traj
+    assert x_traj.shape == (21, 4)
+    assert u_traj.shape == (20, 1)
+    np.testing.assert_allclose(x_traj[0], [0.0, 0.0, 0.1, 0.0], atol=1e-6)
+
+    # The views are refreshed in place by the next solve
+    x_traj_prev = x_traj.copy()
+    solver.set_initial_state([0.0, 0.0, -0.1, 0.0])
+    assert solver.solve() == 0
+    assert np.shares_memory(x_traj, solver.x_traj)
+    np.testing.assert_allclose(x_traj[0], [0.0, 0.0, -0.1, 0.0], atol=1e-6)
+    assert not np.allclose(x_traj, x_traj_prev)
+
+
+def test_simulate(loader):
+    solver = loader.load_solver_plugin(MOCK_SOLVER_PLUGIN, N=20, Ts=0.05)
+    x0 = np.array([0.0, 0.0, 0.1, 0.0])
+    assert solver.simulate(0.05, x0, [0.0], [1.0, 0.1]) == 0
+    assert solver.x_next.shape == (4,)
+    assert not np.allclose(solver.x_next, x0)